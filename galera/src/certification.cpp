@@ -7,6 +7,8 @@
 
 #include "gu_lock.hpp"
 #include "gu_throw.hpp"
+#include "gu_time.h"
+#include "gu_event_trace.hpp"
 
 #include <map>
 
@@ -18,11 +20,14 @@ static const bool cert_debug_on(false);
     else log_info << "cert debug: "
 
 #define CERT_PARAM_LOG_CONFLICTS galera::Certification::PARAM_LOG_CONFLICTS
+#define CERT_PARAM_EXACT_DEPS    galera::Certification::PARAM_EXACT_DEPS
 
 static std::string const CERT_PARAM_PREFIX("cert.");
 
 std::string const galera::Certification::PARAM_LOG_CONFLICTS(CERT_PARAM_PREFIX +
                                                              "log_conflicts");
+std::string const galera::Certification::PARAM_EXACT_DEPS(CERT_PARAM_PREFIX +
+                                                          "exact_deps");
 
 static std::string const CERT_PARAM_MAX_LENGTH   (CERT_PARAM_PREFIX +
                                                   "max_length");
@@ -30,6 +35,7 @@ static std::string const CERT_PARAM_LENGTH_CHECK (CERT_PARAM_PREFIX +
                                                   "length_check");
 
 static std::string const CERT_PARAM_LOG_CONFLICTS_DEFAULT("no");
+static std::string const CERT_PARAM_EXACT_DEPS_DEFAULT   ("no");
 
 /*** It is EXTREMELY important that these constants are the same on all nodes.
  *** Don't change them ever!!! ***/
@@ -40,6 +46,7 @@ void
 galera::Certification::register_params(gu::Config& cnf)
 {
     cnf.add(CERT_PARAM_LOG_CONFLICTS, CERT_PARAM_LOG_CONFLICTS_DEFAULT);
+    cnf.add(CERT_PARAM_EXACT_DEPS,    CERT_PARAM_EXACT_DEPS_DEFAULT);
     /* The defaults below are deliberately not reflected in conf: people
      * should not know about these dangerous setting unless they read RTFM. */
     cnf.add(CERT_PARAM_MAX_LENGTH);
@@ -140,6 +147,7 @@ galera::Certification::purge_for_trx_v3(TrxHandle* trx)
             if (kep->referenced() == false)
             {
                 cert_index_ng_.erase(ci);
+                key_filter_.erase(kp);
                 delete kep;
             }
         }
@@ -515,6 +523,8 @@ certify_and_depend_v3(const galera::KeyEntryNG*   const found,
     wsrep_seqno_t depends_seqno(ref_seqno);
     galera::KeySet::Key::Prefix const pfx (key.prefix());
 
+    trx->add_dep(ref_seqno);
+
     if (pfx == galera::KeySet::Key::P_EXCLUSIVE)
         // exclusive keys must depend on shared refs as well
     {
@@ -530,6 +540,10 @@ certify_and_depend_v3(const galera::KeyEntryNG*   const found,
 
             depends_seqno = std::max(ref_shared_trx->global_seqno(),
                                      depends_seqno);
+
+            // only the latest shared ref is indexed while earlier ones
+            // may still be applying, so wait for all of them
+            trx->raise_deps_floor(ref_shared_trx->global_seqno());
         }
     }
 
@@ -542,19 +556,27 @@ certify_and_depend_v3(const galera::KeyEntryNG*   const found,
 /* returns true on collision, false otherwise */
 static bool
 certify_v3(galera::Certification::CertIndexNG& cert_index_ng,
+           galera::KeyFilter&                  key_filter,
            const galera::KeySet::KeyPart&      key,
            galera::TrxHandle*                  trx,
            bool const store_keys, bool const   log_conflicts)
 {
     galera::KeyEntryNG ke(key);
-    galera::Certification::CertIndexNG::iterator ci(cert_index_ng.find(&ke));
+    // most keys are new to the index, filter saves probing the table for them
+    galera::Certification::CertIndexNG::iterator ci(
+        key_filter.may_contain(key) ?
+        cert_index_ng.find(&ke) : cert_index_ng.end());
 
     if (cert_index_ng.end() == ci)
     {
         if (store_keys)
         {
             galera::KeyEntryNG* const kep(new galera::KeyEntryNG(ke));
-            ci = cert_index_ng.insert(kep).first;
+            std::pair<galera::Certification::CertIndexNG::iterator, bool> const
+                res(cert_index_ng.insert(kep));
+            assert(res.second); // filter must not give false negatives
+            ci = res.first;
+            key_filter.insert(key);
 
             cert_debug << "created new entry";
         }
@@ -595,13 +617,15 @@ galera::Certification::do_test_v3(TrxHandle* trx, bool store_keys)
     {
         const KeySet::KeyPart& key(key_set.next());
 
-        if (certify_v3(cert_index_ng_, key, trx, store_keys, log_conflicts_))
+        if (certify_v3(cert_index_ng_, key_filter_, key, trx, store_keys,
+                       log_conflicts_))
         {
             goto cert_fail;
         }
     }
 
     trx->set_depends_seqno(std::max(trx->depends_seqno(), last_pa_unsafe_));
+    trx->add_dep(last_pa_unsafe_);
 
     if (store_keys == true)
     {
@@ -662,6 +686,7 @@ cert_fail:
                     // kel was added to cert_index_ by this trx -
                     // remove from cert_index_ and fall through to delete
                     cert_index_ng_.erase(ci);
+                    key_filter_.erase(kep->key());
                 }
                 else continue;
 
@@ -699,6 +724,20 @@ galera::Certification::do_test(TrxHandle* trx, bool store_keys)
         return TEST_FAILED;
     }
 
+    /* trx protocol version stays the same when key hash function changes,
+     * keys hashed differently never match, see KeySet::fast_hash() */
+    if (trx->new_version() &&
+        trx->write_set_in().keyset().version() != KeySet::EMPTY &&
+        KeySet::fast_hash(trx->write_set_in().keyset().version()) !=
+        fast_key_hash_)
+    {
+        log_warn << "trx key set version: "
+                 << trx->write_set_in().keyset().version()
+                 << " does not match certification key hash function: "
+                 << (fast_key_hash_ ? "fast" : "MMH3");
+        return TEST_FAILED;
+    }
+
     if (gu_unlikely(trx->last_seen_seqno() < initial_position_ ||
                     trx->global_seqno() - trx->last_seen_seqno() > max_length_))
     {
@@ -726,6 +765,7 @@ galera::Certification::do_test(TrxHandle* trx, bool store_keys)
     TestResult res(TEST_FAILED);
 
     gu::Lock lock(mutex_); // why do we need that? - e.g. set_trx_committed()
+    gu::Lock index_lock(index_mutex_); // purge_index() in service thread
 
     /* initialize parent seqno */
     if ((trx->flags() & (TrxHandle::F_ISOLATION | TrxHandle::F_PA_UNSAFE))
@@ -739,6 +779,12 @@ galera::Certification::do_test(TrxHandle* trx, bool store_keys)
             trx_map_.begin()->second->global_seqno() - 1);
     }
 
+    /* exact dependencies are collected only by v3 certification */
+    if (exact_deps_ && version_ >= 3)
+        trx->track_deps(trx->depends_seqno());
+    else
+        trx->untrack_deps();
+
     switch (version_)
     {
     case 1:
@@ -798,11 +844,32 @@ galera::Certification::do_test_preordered(TrxHandle* trx)
         assert(0);
     }
 
-    trx->set_depends_seqno(last_preordered_seqno_ -
-                           trx->write_set_in().pa_range() + 1);
-    // +1 compensates for subtracting from a previous seqno, rather than own.
+    /* pa_range counts preordered events, which may be interleaved with
+     * other writesets in the global order, so the dependency is the seqno
+     * of the preordered event (pa_range - 1) back from the last one, not
+     * the seqno (pa_range - 1) back from it. Only the latest pa_range
+     * seqnos are kept: earlier events are at least a seqno apart each,
+     * which gives a conservative estimate for the ones not kept. */
+    size_t const pa_range(trx->write_set_in().pa_range());
+    size_t const known(preordered_seqnos_.size());
+
+    assert(pa_range > 0);
+    assert(known > 0);
+
+    if (gu_likely(pa_range <= known))
+    {
+        trx->set_depends_seqno(preordered_seqnos_[known - pa_range]);
+    }
+    else
+    {
+        trx->set_depends_seqno(preordered_seqnos_.front() -
+                               (pa_range - known));
+    }
+
+    preordered_seqnos_.push_back(trx->global_seqno());
+    while (preordered_seqnos_.size() > pa_range)
+        preordered_seqnos_.pop_front();
 
-    last_preordered_seqno_ = trx->global_seqno();
     last_preordered_id_    = trx->trx_id();
 
     return TEST_OK;
@@ -812,18 +879,23 @@ galera::Certification::do_test_preordered(TrxHandle* trx)
 galera::Certification::Certification(gu::Config& conf, ServiceThd& thd)
     :
     version_               (-1),
+    fast_key_hash_         (false),
     trx_map_               (),
     cert_index_            (),
     cert_index_ng_         (),
+    key_filter_            (),
     deps_set_              (),
     service_thd_           (thd),
     mutex_                 (),
+    index_mutex_           (),
+    purge_queue_           (),
+    purge_release_seqno_   (-1),
     trx_size_warn_count_   (0),
     initial_position_      (-1),
     position_              (-1),
     safe_to_discard_seqno_ (-1),
     last_pa_unsafe_        (-1),
-    last_preordered_seqno_ (position_),
+    preordered_seqnos_     (1, position_),
     last_preordered_id_    (0),
     stats_mutex_           (),
     n_certified_           (0),
@@ -836,7 +908,8 @@ galera::Certification::Certification(gu::Config& conf, ServiceThd& thd)
 
     max_length_            (max_length(conf)),
     max_length_check_      (length_check(conf)),
-    log_conflicts_         (conf.get<bool>(CERT_PARAM_LOG_CONFLICTS))
+    log_conflicts_         (conf.get<bool>(CERT_PARAM_LOG_CONFLICTS)),
+    exact_deps_            (conf.get<bool>(CERT_PARAM_EXACT_DEPS))
 {}
 
 
@@ -856,6 +929,7 @@ galera::Certification::~Certification()
 
     gu::Lock lock(mutex_);
 
+    purge_index_all_();
     for_each(trx_map_.begin(), trx_map_.end(), PurgeAndDiscard(*this));
     service_thd_.release_seqno(position_);
     service_thd_.flush();
@@ -863,7 +937,8 @@ galera::Certification::~Certification()
 
 
 void galera::Certification::assign_initial_position(wsrep_seqno_t seqno,
-                                                    int           version)
+                                                    int           version,
+                                                    bool          fast_key_hash)
 {
     switch (version)
     {
@@ -883,6 +958,7 @@ void galera::Certification::assign_initial_position(wsrep_seqno_t seqno,
 
     if (seqno >= position_)
     {
+        purge_index_all_();
         std::for_each(trx_map_.begin(), trx_map_.end(), PurgeAndDiscard(*this));
         assert(cert_index_.size() == 0);
         assert(cert_index_ng_.size() == 0);
@@ -891,6 +967,9 @@ void galera::Certification::assign_initial_position(wsrep_seqno_t seqno,
     {
         log_warn << "moving position backwards: " << position_ << " -> "
                  << seqno;
+
+        gu::Lock index_lock(index_mutex_); // purge_index() in service thread
+
         std::for_each(cert_index_.begin(), cert_index_.end(),
                       gu::DeleteObject());
         std::for_each(cert_index_ng_.begin(), cert_index_ng_.end(),
@@ -899,6 +978,13 @@ void galera::Certification::assign_initial_position(wsrep_seqno_t seqno,
                       Unref2nd<TrxMap::value_type>());
         cert_index_.clear();
         cert_index_ng_.clear();
+        key_filter_.clear();
+
+        for (size_t i(0); i < purge_queue_.size(); ++i)
+        {
+            purge_queue_[i]->unref();
+        }
+        purge_queue_.clear();
     }
 
     trx_map_.clear();
@@ -906,15 +992,17 @@ void galera::Certification::assign_initial_position(wsrep_seqno_t seqno,
     service_thd_.flush();
 
     log_info << "Assign initial position for certification: " << seqno
-             << ", protocol version: " << version;
+             << ", protocol version: " << version
+             << ", fast key hash: " << (fast_key_hash ? "yes" : "no");
 
     initial_position_      = seqno;
     position_              = seqno;
     safe_to_discard_seqno_ = seqno;
     last_pa_unsafe_        = seqno;
-    last_preordered_seqno_ = position_;
+    preordered_seqnos_.assign(1, position_);
     last_preordered_id_    = 0;
     version_               = version;
+    fast_key_hash_         = fast_key_hash;
 }
 
 
@@ -962,10 +1050,26 @@ galera::Certification::purge_trxs_upto_(wsrep_seqno_t const seqno,
 
     cert_debug << "purging index up to " << seqno;
 
-    for_each(trx_map_.begin(), purge_bound, PurgeAndDiscard(*this));
+    /* Index keys are purged by service thread in purge_index(), here trxs
+     * are only queued for that. Write sets can be released from gcache
+     * only after their keys are purged. */
+    {
+        gu::Lock lock(index_mutex_);
+
+        for (TrxMap::iterator i(trx_map_.begin()); i != purge_bound; ++i)
+        {
+            purge_queue_.push_back(i->second);
+        }
+
+        if (handle_gcache && seqno > purge_release_seqno_)
+        {
+            purge_release_seqno_ = seqno;
+        }
+    }
+
     trx_map_.erase(trx_map_.begin(), purge_bound);
 
-    if (handle_gcache) service_thd_.release_seqno(seqno);
+    service_thd_.purge_index(*this);
 
     if (0 == ((trx_map_.size() + 1) % 10000))
     {
@@ -978,12 +1082,62 @@ galera::Certification::purge_trxs_upto_(wsrep_seqno_t const seqno,
 }
 
 
+bool
+galera::Certification::purge_index(long long const slice_ns)
+{
+    long long const until(gu_time_monotonic() + slice_ns);
+    wsrep_seqno_t   release(-1);
+    bool            done(false);
+
+    do
+    {
+        gu::Lock lock(index_mutex_);
+
+        if (!purge_queue_.empty())
+        {
+            PurgeAndDiscard(*this)(purge_queue_.front());
+            purge_queue_.pop_front();
+        }
+
+        if (purge_queue_.empty())
+        {
+            release = purge_release_seqno_;
+            done    = true;
+        }
+        else
+        {
+            release = std::min(purge_release_seqno_,
+                               purge_queue_.front()->global_seqno() - 1);
+        }
+    }
+    while (!done && gu_time_monotonic() < until);
+
+    if (release > 0) service_thd_.release_seqno(release);
+
+    return done;
+}
+
+
+void
+galera::Certification::purge_index_all_()
+{
+    gu::Lock lock(index_mutex_);
+
+    std::for_each(purge_queue_.begin(), purge_queue_.end(),
+                  PurgeAndDiscard(*this));
+    purge_queue_.clear();
+}
+
+
 galera::Certification::TestResult
 galera::Certification::append_trx(TrxHandle* trx)
 {
     assert(trx->global_seqno() >= 0 && trx->local_seqno() >= 0);
     assert(trx->global_seqno() > position_);
 
+    gu::EventTrace::record(gu::EventTrace::CERT_BEGIN, trx->global_seqno(),
+                           trx->trx_id());
+
     trx->ref();
     {
         gu::Lock lock(mutex_);
@@ -1045,6 +1199,9 @@ galera::Certification::append_trx(TrxHandle* trx)
 
     trx->mark_certified();
 
+    gu::EventTrace::record(gu::EventTrace::CERT_END, trx->global_seqno(),
+                           trx->trx_id());
+
     return retval;
 }
 
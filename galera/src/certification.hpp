@@ -7,6 +7,7 @@
 
 #include "trx_handle.hpp"
 #include "key_entry_ng.hpp"
+#include "key_filter.hpp"
 #include "galera_service_thd.hpp"
 
 #include "gu_unordered.hpp"
@@ -16,6 +17,7 @@
 #include <map>
 #include <set>
 #include <list>
+#include <deque>
 
 namespace galera
 {
@@ -24,6 +26,7 @@ namespace galera
     public:
 
         static std::string const PARAM_LOG_CONFLICTS;
+        static std::string const PARAM_EXACT_DEPS;
 
         static void register_params(gu::Config&);
 
@@ -51,7 +54,10 @@ namespace galera
         Certification(gu::Config& conf, ServiceThd& thd);
         ~Certification();
 
-        void assign_initial_position(wsrep_seqno_t seqno, int versiono);
+        /* fast_key_hash: key sets hashed with KeySet::fast_hash() function
+         * are expected, see KeySet::fast_hash_for_repl_proto() */
+        void assign_initial_position(wsrep_seqno_t seqno, int version,
+                                     bool fast_key_hash);
         TestResult append_trx(TrxHandle*);
         TestResult test(TrxHandle*, bool = true);
         wsrep_seqno_t position() const { return position_; }
@@ -75,6 +81,12 @@ namespace galera
             return purge_trxs_upto_(std::min(seqno, stds), handle_gcache);
         }
 
+        // Purges index keys of trxs removed from trx map by
+        // purge_trxs_upto() for about slice_ns nanoseconds. Index is
+        // locked for one trx at a time. Called from service thread.
+        // Return true if nothing is left to purge.
+        bool purge_index(long long slice_ns);
+
         // Set trx corresponding to handle committed. Return purge seqno if
         // index purge is required, -1 otherwise.
         wsrep_seqno_t set_trx_committed(TrxHandle*);
@@ -107,6 +119,9 @@ namespace galera
 
         void set_log_conflicts(const std::string& str);
 
+        /*! true if certified trxs carry exact dependency sets */
+        bool exact_deps() const { return exact_deps_; }
+
     private:
 
         TestResult do_test(TrxHandle*, bool);
@@ -120,6 +135,7 @@ namespace galera
         // unprotected variants for internal use
         wsrep_seqno_t get_safe_to_discard_seqno_() const;
         wsrep_seqno_t purge_trxs_upto_(wsrep_seqno_t, bool sync);
+        void          purge_index_all_();
 
         bool index_purge_required()
         {
@@ -143,9 +159,13 @@ namespace galera
             PurgeAndDiscard(Certification& cert) : cert_(cert) { }
 
             void operator()(TrxMap::value_type& vt) const
+            {
+                operator()(vt.second);
+            }
+
+            void operator()(TrxHandle* const trx) const
             {
                 {
-                    TrxHandle* trx(vt.second);
                     TrxHandleLock lock(*trx);
 
                     if (trx->is_committed() == false)
@@ -165,7 +185,7 @@ namespace galera
                                   << " refcnt " << trx->refcnt();
                     }
                 }
-                vt.second->unref();
+                trx->unref();
             }
 
             PurgeAndDiscard(const PurgeAndDiscard& other) : cert_(other.cert_)
@@ -178,18 +198,23 @@ namespace galera
         };
 
         int           version_;
+        bool          fast_key_hash_;
         TrxMap        trx_map_;
         CertIndex     cert_index_;
         CertIndexNG   cert_index_ng_;
+        KeyFilter     key_filter_;   // follows cert_index_ng_ contents
         DepsSet       deps_set_;
         ServiceThd&   service_thd_;
         gu::Mutex     mutex_;
+        gu::Mutex     index_mutex_;  // index and purge queue, see test()
+        std::deque<TrxHandle*> purge_queue_;
+        wsrep_seqno_t purge_release_seqno_; // release gcache after purge
         size_t        trx_size_warn_count_;
         wsrep_seqno_t initial_position_;
         wsrep_seqno_t position_;
         wsrep_seqno_t safe_to_discard_seqno_;
         wsrep_seqno_t last_pa_unsafe_;
-        wsrep_seqno_t last_preordered_seqno_;
+        std::deque<wsrep_seqno_t> preordered_seqnos_; // latest preordered
         wsrep_trx_id_t last_preordered_id_;
         gu::Mutex     stats_mutex_;
         size_t        n_certified_;
@@ -211,6 +236,7 @@ namespace galera
         unsigned int const max_length_check_; /* Mask how often to check */
 
         bool               log_conflicts_;
+        bool         const exact_deps_;
     };
 }
 
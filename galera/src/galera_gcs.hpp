@@ -44,7 +44,7 @@ namespace galera
                               gcs_action& act, bool) = 0;
         virtual ssize_t repl (gcs_action& act, bool) = 0;
         virtual gcs_seqno_t caused() = 0;
-        virtual ssize_t schedule() = 0;
+        virtual ssize_t schedule(size_t act_size, bool bulk) = 0;
         virtual ssize_t interrupt(ssize_t) = 0;
         virtual ssize_t resume_recv() = 0;
         virtual ssize_t set_last_applied(gcs_seqno_t) = 0;
@@ -143,7 +143,10 @@ namespace galera
 
         gcs_seqno_t caused() { return gcs_caused(conn_);   }
 
-        ssize_t schedule()   { return gcs_schedule(conn_); }
+        ssize_t schedule(size_t act_size, bool bulk)
+        {
+            return gcs_schedule(conn_, act_size, bulk);
+        }
 
         ssize_t interrupt(ssize_t handle)
         {
@@ -313,7 +316,7 @@ namespace galera
 
         gcs_seqno_t caused() { return global_seqno_; }
 
-        ssize_t schedule()
+        ssize_t schedule(size_t, bool)
         {
             return 1;
         }
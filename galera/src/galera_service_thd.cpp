@@ -6,34 +6,47 @@
  */
 
 #include "galera_service_thd.hpp"
+#include "certification.hpp"
+
+#include <gu_thread_affinity.hpp>
 
 const uint32_t galera::ServiceThd::A_NONE = 0;
 
 static const uint32_t A_LAST_COMMITTED = 1U <<  0;
 static const uint32_t A_RELEASE_SEQNO  = 1U <<  1;
+static const uint32_t A_PURGE_INDEX    = 1U <<  2;
 static const uint32_t A_FLUSH          = 1U << 30;
 static const uint32_t A_EXIT           = 1U << 31;
 
+/* sliced actions take one slice per iteration to let other actions through */
+static long long const SLICE_NS(1000000); // 1ms
+
 void*
 galera::ServiceThd::thd_func (void* arg)
 {
     galera::ServiceThd* st = reinterpret_cast<galera::ServiceThd*>(arg);
     bool exit = false;
 
+    gu::ThreadAffinity::apply(gu::ThreadAffinity::SERVICE);
+
     while (!exit)
     {
         galera::ServiceThd::Data data;
+        unsigned long            reset_gen;
 
         {
             gu::Lock lock(st->mtx_);
 
             if (A_NONE == st->data_.act_) lock.wait(st->cond_);
 
-            data = st->data_;
+            data      = st->data_;
+            reset_gen = st->reset_gen_;
             st->data_.act_ = A_NONE; // clear pending actions
 
             if (data.act_ & A_FLUSH)
             {
+                /* unfinished sliced actions are rescheduled before the next
+                 * iteration, so they hold up the flush until they are done */
                 if (A_FLUSH == data.act_)
                 { // no other actions scheduled (all previous are "flushed")
                     log_info << "Service thread queue flushed.";
@@ -73,7 +86,17 @@ galera::ServiceThd::thd_func (void* arg)
             {
                 try
                 {
-                    st->gcache_.seqno_release(data.release_seqno_);
+                    if (!st->gcache_.seqno_release(data.release_seqno_,
+                                                   SLICE_NS))
+                    {
+                        gu::Lock lock(st->mtx_);
+                        /* the rest belongs to the old history after reset,
+                         * otherwise it is done before pending flush */
+                        if (st->reset_gen_ == reset_gen)
+                        {
+                            st->data_.act_ |= A_RELEASE_SEQNO;
+                        }
+                    }
                 }
                 catch (std::exception& e)
                 {
@@ -81,6 +104,14 @@ galera::ServiceThd::thd_func (void* arg)
                              << data.release_seqno_ << ": " << e.what();
                 }
             }
+
+            if (data.act_ & A_PURGE_INDEX)
+            {
+                if (!data.cert_->purge_index(SLICE_NS))
+                {
+                    st->purge_index(*data.cert_);
+                }
+            }
         }
     }
 
@@ -94,7 +125,8 @@ galera::ServiceThd::ServiceThd (GcsI& gcs, gcache::GCache& gcache) :
     mtx_    (),
     cond_   (),
     flush_  (),
-    data_   ()
+    data_   (),
+    reset_gen_(0)
 {
     gu_thread_create (&thd_, NULL, thd_func, this);
 }
@@ -128,8 +160,10 @@ void
 galera::ServiceThd::reset()
 {
     gu::Lock lock(mtx_);
-    data_.act_ = A_NONE;
+    // index purge is not related to gcs, flush callers still wait
+    data_.act_ &= (A_PURGE_INDEX | A_FLUSH);
     data_.last_committed_ = 0;
+    ++reset_gen_; // stops sliced release of the old history
 }
 
 void
@@ -161,3 +195,15 @@ galera::ServiceThd::release_seqno(gcs_seqno_t seqno)
         data_.act_ |= A_RELEASE_SEQNO;
     }
 }
+
+void
+galera::ServiceThd::purge_index(Certification& cert)
+{
+    gu::Lock lock(mtx_);
+
+    data_.cert_ = &cert;
+
+    if (data_.act_ == A_NONE) cond_.signal();
+
+    data_.act_ |= A_PURGE_INDEX;
+}
@@ -12,6 +12,8 @@
 
 namespace galera
 {
+    class Certification;
+
     class ServiceThd
     {
     public:
@@ -20,7 +22,8 @@ namespace galera
 
         ~ServiceThd ();
 
-        /*! flush all ongoing operations (before processing CC) */
+        /*! flush all ongoing operations (before processing CC),
+         *  including all slices of a scheduled seqno release */
         void flush ();
 
         /*! reset to initial state before gcs (re)connect */
@@ -38,19 +41,25 @@ namespace galera
         /*! release write sets up to and including seqno */
         void release_seqno (gcs_seqno_t seqno);
 
+        /*! purge certification index in time slices until it is done,
+         *  see Certification::purge_index() */
+        void purge_index (Certification& cert);
+
     private:
 
         static const uint32_t A_NONE;
 
         struct Data
         {
-            gcs_seqno_t last_committed_;
-            gcs_seqno_t release_seqno_;
-            uint32_t    act_;
+            gcs_seqno_t    last_committed_;
+            gcs_seqno_t    release_seqno_;
+            Certification* cert_;
+            uint32_t       act_;
 
             Data() :
                 last_committed_(0),
                 release_seqno_ (0),
+                cert_          (0),
                 act_           (A_NONE)
             {}
         };
@@ -62,6 +71,7 @@ namespace galera
         gu::Cond        cond_;  // service request condition
         gu::Cond        flush_; // flush condition
         Data            data_;
+        unsigned long   reset_gen_; // number of reset() calls
 
         static void* thd_func (void*);
 
@@ -8,6 +8,7 @@
 #include "gu_logger.hpp"
 #include "gu_uri.hpp"
 #include "gu_debug_sync.hpp"
+#include "gu_thread_affinity.hpp"
 
 #include "GCache.hpp"
 #include "galera_common.hpp"
@@ -127,6 +128,7 @@ galera::ist::Receiver::~Receiver()
 extern "C" void* run_receiver_thread(void* arg)
 {
     galera::ist::Receiver* receiver(static_cast<galera::ist::Receiver*>(arg));
+    gu::ThreadAffinity::apply(gu::ThreadAffinity::IST);
     receiver->run();
     return 0;
 }
@@ -706,6 +708,7 @@ extern "C"
 void* run_async_sender(void* arg)
 {
     galera::ist::AsyncSender* as(reinterpret_cast<galera::ist::AsyncSender*>(arg));
+    gu::ThreadAffinity::apply(gu::ThreadAffinity::IST);
     log_info << "async IST sender starting to serve " << as->peer().c_str()
              << " sending " << as->first() << "-" << as->last();
     wsrep_seqno_t join_seqno;
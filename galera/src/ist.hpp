@@ -135,7 +135,7 @@ namespace galera
         class AsyncSenderMap
         {
         public:
-            AsyncSenderMap(GCS_IMPL& gcs, gcache::GCache& gcache)
+            explicit AsyncSenderMap(gcache::GCache& gcache)
                 :
                 senders_(),
                 monitor_(),
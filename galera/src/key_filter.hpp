@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2014 Codership Oy <info@codership.com>
+//
+
+#ifndef GALERA_KEY_FILTER_HPP
+#define GALERA_KEY_FILTER_HPP
+
+#include "key_set.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+namespace galera
+{
+    /*!
+     * Counting Bloom filter over key part hashes. Follows the contents of
+     * certification index: negative answer from may_contain() means that
+     * the key is definitely not in the index and the lookup can be skipped.
+     *
+     * Each key sets two 8-bit counters. Counters that reach the maximum stick
+     * there and are never decremented, so overflow may only cost false
+     * positives, never false negatives.
+     */
+    class KeyFilter
+    {
+    public:
+
+        static int const DEFAULT_BITS = 20; // 1M counters, 1MiB of memory
+
+        explicit KeyFilter(int const bits = DEFAULT_BITS)
+            :
+            counts_(size_t(1) << bits, 0),
+            mask_  ((size_t(1) << bits) - 1),
+            shift_ (64 - bits)
+        {
+            assert(bits > 0 && bits < 32);
+        }
+
+        void insert(const KeySet::KeyPart& kp) { insert(kp.hash()); }
+        void erase (const KeySet::KeyPart& kp) { erase (kp.hash()); }
+        bool may_contain(const KeySet::KeyPart& kp) const
+        {
+            return may_contain(kp.hash());
+        }
+
+        void insert(size_t const hash)
+        {
+            inc(idx0(hash));
+            inc(idx1(hash));
+        }
+
+        void erase(size_t const hash)
+        {
+            dec(idx0(hash));
+            dec(idx1(hash));
+        }
+
+        bool may_contain(size_t const hash) const
+        {
+            return (counts_[idx0(hash)] != 0 && counts_[idx1(hash)] != 0);
+        }
+
+        void clear() { std::fill(counts_.begin(), counts_.end(), 0); }
+
+    private:
+
+        static unsigned char const STICKY = 0xff;
+
+        std::vector<unsigned char> counts_;
+        size_t const               mask_;
+        int const                  shift_;
+
+        size_t idx0(size_t const hash) const
+        {
+            return (hash & mask_);
+        }
+
+        /* Fibonacci hashing takes the bits independent from idx0() */
+        size_t idx1(size_t const hash) const
+        {
+            return ((uint64_t(hash) * 0x9E3779B97F4A7C15ULL) >> shift_);
+        }
+
+        void inc(size_t const idx)
+        {
+            if (counts_[idx] < STICKY) ++counts_[idx];
+        }
+
+        void dec(size_t const idx)
+        {
+            assert(counts_[idx] > 0);
+            if (counts_[idx] < STICKY) --counts_[idx];
+        }
+    };
+}
+
+#endif // GALERA_KEY_FILTER_HPP
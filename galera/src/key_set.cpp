@@ -6,6 +6,7 @@
 
 #include "gu_logger.hpp"
 #include "gu_hexdump.hpp"
+#include "gu_spooky.h"
 
 #include <limits>
 #include <algorithm> // std::transform
@@ -21,7 +22,8 @@ KeySet::throw_version(int ver)
 
 static const char* ver_str[KeySet::MAX_VERSION + 1] =
 {
-    "EMPTY", "FLAT8", "FLAT8A", "FLAT16", "FLAT16A"
+    "EMPTY", "FLAT8", "FLAT8A", "FLAT16", "FLAT16A",
+    "FLAT8S", "FLAT16S", "FLAT16SA"
 };
 
 KeySet::Version
@@ -38,6 +40,56 @@ KeySet::version (const std::string& ver)
     gu_throw_error(EINVAL) << "Unsupported KeySet version: " << ver; throw;
 }
 
+KeySet::Version
+KeySet::version (Version const ver, bool const fast)
+{
+    /* there is no 8-byte annotated fast hash version, FLAT8A is mapped to
+     * FLAT16SA and back to FLAT16A */
+    static Version const to_fast[MAX_VERSION + 1] =
+    {
+        EMPTY, FLAT8S, FLAT16SA, FLAT16S, FLAT16SA, FLAT8S, FLAT16S, FLAT16SA
+    };
+    static Version const to_slow[MAX_VERSION + 1] =
+    {
+        EMPTY, FLAT8,  FLAT8A,   FLAT16,  FLAT16A,  FLAT8,  FLAT16,  FLAT16A
+    };
+
+    return (fast ? to_fast[version(ver)] : to_slow[version(ver)]);
+}
+
+void
+KeySet::hash_parts (const PartHash&          parent,
+                    const wsrep_buf_t* const parts,
+                    int const                num,
+                    PartHash* const          res)
+{
+    const PartHash* seed(&parent);
+
+    for (int i(0); i < num; seed = &res[i], ++i)
+    {
+        const wsrep_buf_t& p(parts[i]);
+
+        /* short hash is several times faster for typical key parts, but
+         * can't take longer ones */
+        if (gu_likely(p.len < _spooky_bufSize))
+        {
+            res[i] = *seed;
+            gu_spooky_short_seed_host(p.ptr, p.len, res[i].h);
+        }
+        else
+        {
+            /* long hash takes no seed, mix the seed in afterwards */
+            uint64_t a(seed->h[0]), b(seed->h[1]), c[2];
+
+            gu_spooky128_host(p.ptr, p.len, c);
+            _spooky_short_end(&a, &b, &c[0], &c[1]);
+
+            res[i].h[0] = a;
+            res[i].h[1] = b;
+        }
+    }
+}
+
 size_t
 KeySet::KeyPart::store_annotation (const wsrep_buf_t* const parts,
                                    int const part_num,
@@ -157,9 +209,11 @@ KeySetOut::KeyPart::KeyPart (KeyParts&      added,
                              KeySetOut&     store,
                              const KeyPart* parent,
                              const KeyData& kd,
-                             int const      part_num)
+                             int const      part_num,
+                             const KeySet::PartHash* const part_hash)
     :
     hash_ (parent->hash_),
+    fhash_(),
     part_ (0),
     value_(reinterpret_cast<const gu::byte_t*>(kd.parts[part_num].ptr)),
     size_ (kd.parts[part_num].len),
@@ -167,14 +221,28 @@ KeySetOut::KeyPart::KeyPart (KeyParts&      added,
     own_  (false)
 {
     assert (ver_);
-    uint32_t const s(gu::htog(size_));
-    hash_.append (&s, sizeof(s));
-    hash_.append (value_, size_);
 
     KeySet::KeyPart::TmpStore ts;
     KeySet::KeyPart::HashData hd;
 
-    hash_.gather<sizeof(hd.buf)>(hd.buf);
+    if (KeySet::fast_hash(ver_))
+    {
+        assert (part_hash);
+
+        fhash_ = *part_hash;
+
+        uint64_t const tmp[2] =
+            { gu::htog(fhash_.h[0]), gu::htog(fhash_.h[1]) };
+        ::memcpy (hd.buf, tmp, sizeof(hd.buf));
+    }
+    else
+    {
+        uint32_t const s(gu::htog(size_));
+        hash_.append (&s, sizeof(s));
+        hash_.append (value_, size_);
+
+        hash_.gather<sizeof(hd.buf)>(hd.buf);
+    }
 
     /* only leaf part of the key can be exclusive */
     bool const leaf (part_num + 1 == kd.parts_num);
@@ -333,6 +401,14 @@ KeySetOut::append (const KeyData& kd)
     const KeyPart* const parent(&tmp);
 #endif /* CHECK_PREVIOUS_KEY */
 
+    if (KeySet::fast_hash(version_))
+    {
+        /* hash all new parts at once */
+        hashes_().resize(kd.parts_num - i);
+        KeySet::hash_parts(parent->fast_hash(), kd.parts + i,
+                           kd.parts_num - i, &hashes_[0]);
+    }
+
     /* create parts that didn't match previous key and add to the set
      * of preiously added keys. */
     size_t const old_size (size());
@@ -341,7 +417,8 @@ KeySetOut::append (const KeyData& kd)
     {
         try
         {
-            KeyPart kp(added_, *this, parent, kd, i);
+            KeyPart kp(added_, *this, parent, kd, i,
+                       KeySet::fast_hash(version_) ? &hashes_[j] : NULL);
 
 #ifdef CHECK_PREVIOUS_KEY
             if (size_t(j) < new_.size())
@@ -31,7 +31,10 @@ public:
         FLAT16,   /* 16-byte hash (flat) */
         FLAT16A,  /* 16-byte hash (flat), annotated */
 //      TREE8,    /*  8-byte hash + full serialized key */
-        MAX_VERSION = FLAT16A
+        FLAT8S,   /*  8-byte fast hash (flat) */
+        FLAT16S,  /* 16-byte fast hash (flat) */
+        FLAT16SA, /* 16-byte fast hash (flat), annotated */
+        MAX_VERSION = FLAT16SA
     };
 
     static Version version (unsigned int ver)
@@ -43,6 +46,32 @@ public:
 
     static Version version (const std::string& ver);
 
+    /* Versions from FLAT8S on hash key parts with SpookyHash instead of
+     * MMH3. Hashes of different functions never match, so all members must
+     * use the same one, it is selected by replication protocol version. */
+    static bool fast_hash (Version const ver) { return ver >= FLAT8S; }
+
+    /* whether replication protocol version repl_proto_ver uses fast hash */
+    static bool fast_hash_for_repl_proto (int const repl_proto_ver)
+    {
+        return repl_proto_ver >= 8;
+    }
+
+    /* returns version closest to ver that uses the requested hash function */
+    static Version version (Version ver, bool fast);
+
+    /* Fast hash of a key part, in host byte order. It covers all the
+     * preceding parts of the key as each part is hashed with the hash of
+     * its parent as a seed. */
+    struct PartHash { uint64_t h[2]; };
+
+    /* Computes fast hashes of num consecutive key parts in one call,
+     * the first one is hashed with parent as a seed. */
+    static void hash_parts (const PartHash&    parent,
+                            const wsrep_buf_t* parts,
+                            int                num,
+                            PartHash*          res);
+
     class Key
     {
     public:
@@ -82,9 +111,7 @@ public:
         {
             assert(ver > EMPTY && ver <= MAX_VERSION);
 
-            /* 16 if ver in { FLAT16, FLAT16A }, 8 otherwise */
-            int const key_size
-                (8 << (static_cast<unsigned int>(ver - FLAT16) <= 1));
+            int const key_size(base_size(ver, NULL, 0));
 
             memcpy (tmp.buf, hash.buf, key_size);
 
@@ -161,6 +188,11 @@ public:
             const uint32_t* rhs(reinterpret_cast<const uint32_t*>(kp.data_));
 #endif /* WORDSIZE */
 
+            /* both hash functions are never used at the same time,
+             * see fast_hash() */
+            assert(fast_hash(version()) == fast_hash(kp.version()) ||
+                   EMPTY == version() || EMPTY == kp.version());
+
             switch (std::min(version(), kp.version()))
             {
             case EMPTY:
@@ -168,6 +200,8 @@ public:
                 throw_match_empty_key(version(), kp.version());
             case FLAT16:
             case FLAT16A:
+            case FLAT16S:
+            case FLAT16SA:
 #if GU_WORDSIZE == 64
                 ret = (lhs[1] == rhs[1]);
 #else
@@ -175,6 +209,7 @@ public:
 #endif /* WORDSIZE */
             case FLAT8:
             case FLAT8A:
+            case FLAT8S:
                 /* shift is to clear up the header */
 #if GU_WORDSIZE == 64
                 ret = ret && ((gtoh64(lhs[0]) >> HEADER_BITS) ==
@@ -257,9 +292,12 @@ public:
             {
             case FLAT16:
             case FLAT16A:
+            case FLAT16S:
+            case FLAT16SA:
                 return 16;
             case FLAT8:
             case FLAT8A:
+            case FLAT8S:
                 return 8;
             case EMPTY: assert(0);
             }
@@ -270,7 +308,7 @@ public:
         static bool
         annotated (Version const ver)
         {
-            return (ver == FLAT16A || ver == FLAT8A);
+            return (ver == FLAT16A || ver == FLAT8A || ver == FLAT16SA);
         }
 
         typedef uint16_t ann_size_t;
@@ -510,6 +548,7 @@ public:
         KeyPart (KeySet::Version const ver = KeySet::FLAT16)
             :
             hash_ (),
+            fhash_(),
             part_ (0),
             value_(0),
             size_ (0),
@@ -522,15 +561,19 @@ public:
         /* to throw in KeyPart() ctor in case it is a duplicate */
         class DUPLICATE {};
 
+        /* part_hash is required by fast hash versions,
+         * see KeySet::hash_parts() */
         KeyPart (KeyParts&      added,
                  KeySetOut&     store,
                  const KeyPart* parent,
                  const KeyData& kd,
-                 int const      part_num);
+                 int const      part_num,
+                 const KeySet::PartHash* part_hash);
 
         KeyPart (const KeyPart& k)
         :
         hash_ (k.hash_),
+        fhash_(k.fhash_),
         part_ (k.part_),
         value_(k.value_),
         size_ (k.size_),
@@ -547,6 +590,7 @@ public:
             using std::swap;
 
             swap (l.hash_,  r.hash_ );
+            swap (l.fhash_, r.fhash_);
             swap (l.part_,  r.part_ );
             swap (l.value_, r.value_);
             swap (l.size_,  r.size_ );
@@ -569,6 +613,9 @@ public:
         bool
         shared () const { return !exclusive(); }
 
+        const KeySet::PartHash&
+        fast_hash () const { return fhash_; }
+
         void
         acquire()
         {
@@ -598,6 +645,7 @@ public:
     private:
 
         gu::Hash          hash_;
+        KeySet::PartHash  fhash_;
         const KeySet::KeyPart* part_;
         mutable
         const gu::byte_t* value_;
@@ -615,6 +663,7 @@ public:
         added_(),
         prev_ (),
         new_  (),
+        hashes_(),
         version_()
     {}
 
@@ -633,6 +682,7 @@ public:
         added_(),
         prev_ (),
         new_  (),
+        hashes_(),
         version_(version)
     {
         assert (version_ != KeySet::EMPTY);
@@ -654,6 +704,7 @@ private:
     KeyParts              added_;
     gu::Vector<KeyPart,5> prev_;
     gu::Vector<KeyPart,5> new_;
+    gu::Vector<KeySet::PartHash,5> hashes_; // fast hashes of new_ parts
     KeySet::Version       version_;
 
     static gu::RecordSet::CheckType
@@ -712,6 +763,8 @@ public:
     KeySet::KeyPart const
     next () const { return gu::RecordSetIn<KeySet::KeyPart>::next(); }
 
+    KeySet::Version version () const { return version_; }
+
 private:
 
     KeySet::Version version_;
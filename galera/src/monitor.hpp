@@ -7,6 +7,7 @@
 
 #include "trx_handle.hpp"
 #include <gu_lock.hpp> // for gu::Mutex and gu::Cond
+#include <gu_event_trace.hpp>
 
 #include <vector>
 
@@ -45,7 +46,11 @@ namespace galera
 
     public:
 
-        Monitor()
+        /*! enter and leave events are recorded in gu::EventTrace if given */
+        Monitor(gu::EventTrace::Event const trace_enter =
+                gu::EventTrace::EVENT_MAX,
+                gu::EventTrace::Event const trace_leave =
+                gu::EventTrace::EVENT_MAX)
             :
             mutex_(),
             cond_(),
@@ -56,7 +61,10 @@ namespace galera
             entered_(0),
             oooe_(0),
             oool_(0),
-            win_size_(0)
+            win_size_(0),
+            wake_any_(false),
+            trace_enter_(trace_enter),
+            trace_leave_(trace_leave)
         { }
 
         ~Monitor()
@@ -134,6 +142,9 @@ namespace galera
                     ++entered_;
                     oooe_     += ((last_left_ + 1) < obj_seqno);
                     win_size_ += (last_entered_ - last_left_);
+
+                    if (trace_enter_ != gu::EventTrace::EVENT_MAX)
+                        gu::EventTrace::record(trace_enter_, obj_seqno);
                     return;
                 }
             }
@@ -146,6 +157,9 @@ namespace galera
 
         void leave(const C& obj)
         {
+            if (trace_leave_ != gu::EventTrace::EVENT_MAX)
+                gu::EventTrace::record(trace_leave_, obj.seqno());
+
 #ifndef NDEBUG
             size_t   idx(indexof(obj.seqno()));
 #endif /* NDEBUG */
@@ -233,6 +247,28 @@ namespace galera
         }
         ssize_t       size()        const { return process_size_; }
 
+        /*!
+         * @return true if seqno has left the monitor, possibly out of order.
+         * For use in C::condition() only, i.e. with monitor mutex locked.
+         */
+        bool left(wsrep_seqno_t const seqno) const
+        {
+            return (seqno <= last_left_ ||
+                    (seqno <= last_entered_ &&
+                     process_[seqno & process_mask_].state_ ==
+                     Process::S_FINISHED));
+        }
+
+        /*!
+         * Makes waiters be rechecked on every leave rather than only when
+         * last_left_ advances. Needed when C::condition() uses left().
+         */
+        void set_wake_any(bool const val)
+        {
+            gu::Lock lock(mutex_);
+            wake_any_ = val;
+        }
+
         bool would_block (wsrep_seqno_t seqno) const
         {
             return (seqno - last_left_ >= process_size_ ||
@@ -389,6 +425,7 @@ namespace galera
             else
             {
                 process_[idx].state_ = Process::S_FINISHED;
+                if (wake_any_) wake_up_next();
             }
 
             process_[idx].obj_ = 0;
@@ -440,6 +477,9 @@ namespace galera
         long oooe_;     // out of order entered
         long oool_;     // out of order left
         long win_size_; // window between last_left_ and last_entered_
+        bool wake_any_; // wake up waiters on out of order leave, see left()
+        gu::EventTrace::Event const trace_enter_;
+        gu::EventTrace::Event const trace_leave_;
     };
 }
 
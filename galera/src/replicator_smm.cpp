@@ -10,6 +10,7 @@
 #include "galera_info.hpp"
 
 #include <gu_debug_sync.hpp>
+#include <gu_event_trace.hpp>
 #include <gu_abort.h>
 
 #include <sstream>
@@ -143,7 +144,8 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     state_file_         (config_.get(BASE_DIR)+'/'+GALERA_STATE_FILE),
     st_                 (state_file_),
     trx_params_         (config_.get(BASE_DIR), -1,
-                         KeySet::version(config_.get(Param::key_format)),
+                         key_format(KeySet::version(
+                                        config_.get(Param::key_format))),
                          gu::from_string<int>(config_.get(
                              Param::max_write_set_size))),
     uuid_               (WSREP_UUID_UNDEFINED),
@@ -172,12 +174,14 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     as_                 (0),
     gcs_as_             (slave_pool_, gcs_, *this, gcache_),
     ist_receiver_       (config_, slave_pool_, args->node_address),
-    ist_senders_        (gcs_, gcache_),
+    ist_senders_        (gcache_),
     wsdb_               (),
     cert_               (config_, service_thd_),
     local_monitor_      (),
-    apply_monitor_      (),
-    commit_monitor_     (),
+    apply_monitor_      (gu::EventTrace::APPLY_ENTER,
+                         gu::EventTrace::APPLY_LEAVE),
+    commit_monitor_     (gu::EventTrace::COMMIT_ENTER,
+                         gu::EventTrace::COMMIT_LEAVE),
     causal_read_timeout_(config_.get(Param::causal_read_timeout)),
     receivers_          (),
     replicated_         (),
@@ -228,6 +232,11 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     state_.add_transition(Transition(S_DONOR, S_CONNECTED));
     state_.add_transition(Transition(S_DONOR, S_JOINED));
 
+    gu::EventTrace::init(config_.get<size_t>(Param::trace_size));
+
+    // slave trxs with exact dependencies may enter as soon as these leave
+    apply_monitor_.set_wake_any(cert_.exact_deps());
+
     local_monitor_.set_initial_position(0);
 
     wsrep_uuid_t  uuid;
@@ -255,7 +264,9 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     if (co_mode_ != CommitOrder::BYPASS)
         commit_monitor_.set_initial_position(seqno);
 
-    cert_.assign_initial_position(seqno, trx_proto_ver());
+    cert_.assign_initial_position(
+        seqno, trx_proto_ver(),
+        KeySet::fast_hash_for_repl_proto(protocol_version_));
 
     build_stats_vars(wsrep_stats_);
 }
@@ -421,7 +432,7 @@ void galera::ReplicatorSMM::apply_trx(void* recv_ctx, TrxHandle* trx)
     assert(trx->global_seqno() > STATE_SEQNO());
     assert(trx->is_local() == false);
 
-    ApplyOrder ao(*trx);
+    ApplyOrder ao(*trx, &apply_monitor_);
     CommitOrder co(*trx, co_mode_);
 
     gu_trace(apply_monitor_.enter(ao));
@@ -530,11 +541,13 @@ wsrep_status_t galera::ReplicatorSMM::replicate(TrxHandle* trx,
 
     ssize_t rcode(-1);
 
+    gu::EventTrace::record(gu::EventTrace::GCS_SEND_BEGIN, -1, trx->trx_id());
+
     do
     {
         assert(act.seqno_g == GCS_SEQNO_ILL);
 
-        const ssize_t gcs_handle(gcs_.schedule());
+        const ssize_t gcs_handle(gcs_.schedule(act.size, trx->is_toi()));
 
         if (gu_unlikely(gcs_handle < 0))
         {
@@ -595,6 +608,9 @@ wsrep_status_t galera::ReplicatorSMM::replicate(TrxHandle* trx,
     assert(act.seqno_l != GCS_SEQNO_ILL);
     assert(act.seqno_g != GCS_SEQNO_ILL);
 
+    gu::EventTrace::record(gu::EventTrace::GCS_SEND_END, act.seqno_g,
+                           trx->trx_id());
+
     ++replicated_;
     replicated_bytes_ += rcode;
     trx->set_gcs_handle(-1);
@@ -1269,31 +1285,25 @@ void galera::ReplicatorSMM::establish_protocol_versions (int proto_ver)
     switch (proto_ver)
     {
     case 1:
-        trx_params_.version_ = 1;
         str_proto_ver_ = 0;
         break;
     case 2:
-        trx_params_.version_ = 1;
-        str_proto_ver_ = 1;
-        break;
     case 3:
     case 4:
-        trx_params_.version_ = 2;
-        str_proto_ver_ = 1;
-        break;
     case 5:
-        trx_params_.version_ = 3;
         str_proto_ver_ = 1;
         break;
     case 6:
-        trx_params_.version_  = 3;
         str_proto_ver_ = 2; // gcs intelligent donor selection.
         // include handling dangling comma in donor string.
         break;
     case 7:
         // Protocol upgrade to handle IST SSL backwards compatibility,
         // no effect to TRX or STR protocols.
-        trx_params_.version_ = 3;
+        str_proto_ver_ = 2;
+        break;
+    case 8:
+        // Key parts are hashed with SpookyHash, see KeySet::fast_hash()
         str_proto_ver_ = 2;
         break;
     default:
@@ -1302,7 +1312,12 @@ void galera::ReplicatorSMM::establish_protocol_versions (int proto_ver)
         abort();
     };
 
+    trx_params_.version_ = TrxHandle::version_for_repl_proto(proto_ver);
+    assert(trx_params_.version_ > 0);
+
     protocol_version_ = proto_ver;
+    trx_params_.key_format_ =
+        key_format(KeySet::version(config_.get(Param::key_format)));
     log_info << "REPL Protocols: " << protocol_version_ << " ("
               << trx_params_.version_ << ", " << str_proto_ver_ << ")";
 }
@@ -1415,7 +1430,13 @@ galera::ReplicatorSMM::process_conf_change(void*                    recv_ctx,
 
         // we have to reset cert initial position here, SST does not contain
         // cert index yet (see #197).
-        cert_.assign_initial_position(group_seqno, trx_params_.version_);
+        // Note: every member does this at the same seqno, so a joiner
+        // certifies the following write sets exactly like the donor does,
+        // without an index snapshot. Write sets up to group_seqno come over
+        // IST with donor's depends_seqno and are not certified again.
+        cert_.assign_initial_position(
+            group_seqno, trx_params_.version_,
+            KeySet::fast_hash_for_repl_proto(repl_proto));
         // at this point there is no ongoing master or slave transactions
         // and no new requests to service thread should be possible
 
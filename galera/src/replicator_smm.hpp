@@ -176,6 +176,8 @@ namespace galera
             static const std::string commit_order;
             static const std::string causal_read_timeout;
             static const std::string max_write_set_size;
+            static const std::string trace_size;
+            static const std::string trace_dump;
         };
 
         typedef std::pair<std::string, std::string> Default;
@@ -259,11 +261,16 @@ namespace galera
             TrxHandle*    trx_;
         };
 
+    public:
+
         class ApplyOrder
         {
         public:
 
-            ApplyOrder(TrxHandle& trx) : trx_(trx) { }
+            /*! if mon is given, trx waits only for its exact dependencies
+             *  when it has them (see TrxHandle::deps_tracked()) */
+            ApplyOrder(TrxHandle& trx, const Monitor<ApplyOrder>* mon = 0)
+                : trx_(trx), mon_(mon) { }
 
             void lock()   { trx_.lock();   }
             void unlock() { trx_.unlock(); }
@@ -273,8 +280,19 @@ namespace galera
             bool condition(wsrep_seqno_t last_entered,
                            wsrep_seqno_t last_left) const
             {
-                return (trx_.is_local() == true ||
-                        last_left >= trx_.depends_seqno());
+                if (trx_.is_local() == true) return true;
+
+                if (mon_ == 0 || trx_.deps_tracked() == false)
+                    return (last_left >= trx_.depends_seqno());
+
+                if (last_left < trx_.deps_floor()) return false;
+
+                for (int i(0); i < trx_.deps_count(); ++i)
+                {
+                    if (mon_->left(trx_.dep(i)) == false) return false;
+                }
+
+                return true;
             }
 
 #ifdef GU_DBUG_ON
@@ -302,10 +320,9 @@ namespace galera
         private:
             ApplyOrder(const ApplyOrder&);
             TrxHandle& trx_;
+            const Monitor<ApplyOrder>* const mon_;
         };
 
-    public:
-
         class CommitOrder
         {
         public:
@@ -434,6 +451,14 @@ namespace galera
 
         void establish_protocol_versions (int version);
 
+        // configured key format adjusted to the key hash function of
+        // the current protocol version, see KeySet::fast_hash()
+        KeySet::Version key_format (KeySet::Version const ver) const
+        {
+            return KeySet::version(
+                ver, KeySet::fast_hash_for_repl_proto(protocol_version_));
+        }
+
         bool state_transfer_required(const wsrep_view_info_t& view_info);
 
         void prepare_for_IST (void*& req, ssize_t& req_len,
@@ -497,6 +522,7 @@ namespace galera
          * |                 5 |              3 |              1 |
          * |                 6 |              3 |              2 |
          * |                 7 |              3 |              2 |
+         * |                 8 |              3 |              2 |
          * -------------------------------------------------------
          */
 
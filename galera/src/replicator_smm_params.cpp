@@ -7,6 +7,8 @@
 #include "gu_uri.hpp"
 #include "write_set_ng.hpp"
 #include "gu_throw.hpp"
+#include "gu_event_trace.hpp"
+#include "gu_thread_affinity.hpp"
 
 const std::string galera::ReplicatorSMM::Param::base_host = "base_host";
 const std::string galera::ReplicatorSMM::Param::base_port = "base_port";
@@ -24,8 +26,12 @@ const std::string galera::ReplicatorSMM::Param::key_format =
     common_prefix + "key_format";
 const std::string galera::ReplicatorSMM::Param::max_write_set_size =
     common_prefix + "max_ws_size";
+const std::string galera::ReplicatorSMM::Param::trace_size =
+    common_prefix + "trace_size";
+const std::string galera::ReplicatorSMM::Param::trace_dump =
+    common_prefix + "trace_dump";
 
-int const galera::ReplicatorSMM::MAX_PROTO_VER(7);
+int const galera::ReplicatorSMM::MAX_PROTO_VER(8);
 
 galera::ReplicatorSMM::Defaults::Defaults() : map_()
 {
@@ -38,6 +44,8 @@ galera::ReplicatorSMM::Defaults::Defaults() : map_()
     const int max_write_set_size(galera::WriteSetNG::MAX_SIZE);
     map_.insert(Default(Param::max_write_set_size,
                         gu::to_string(max_write_set_size)));
+    map_.insert(Default(Param::trace_size, "65536"));
+    map_.insert(Default(Param::trace_dump, ""));
 }
 
 const galera::ReplicatorSMM::Defaults galera::ReplicatorSMM::defaults;
@@ -48,6 +56,7 @@ galera::ReplicatorSMM::InitConfig::InitConfig(gu::Config&       conf,
                                               const char* const base_dir)
 {
     gu::ssl_register_params(conf);
+    gu::ThreadAffinity::register_params(conf);
     Replicator::register_params(conf);
 
     std::map<std::string, std::string>::const_iterator i;
@@ -126,6 +135,8 @@ galera::ReplicatorSMM::ParseOptions::ParseOptions(Replicator&       repl,
 {
     conf.parse(opts);
 
+    gu::ThreadAffinity::configure(conf);
+
     if (conf.get<bool>(Replicator::Param::debug_log))
     {
         gu_conf_debug_on();
@@ -170,14 +181,15 @@ galera::ReplicatorSMM::set_param (const std::string& key,
     else if (key == Param::base_host ||
              key == Param::base_port ||
              key == Param::base_dir ||
-             key == Param::proto_max)
+             key == Param::proto_max ||
+             key == Param::trace_size)
     {
         // nothing to do here, these params take effect only at
         // provider (re)start
     }
     else if (key == Param::key_format)
     {
-        trx_params_.key_format_ = KeySet::version(value);
+        trx_params_.key_format_ = key_format(KeySet::version(value));
     }
     else if (key == Param::max_write_set_size)
     {
@@ -195,6 +207,22 @@ void
 galera::ReplicatorSMM::param_set (const std::string& key,
                                   const std::string& value)
 {
+    if (0 == key.find(gu::ThreadAffinity::PARAM_PREFIX) ||
+        key == Certification::PARAM_EXACT_DEPS)
+    {
+        log_error << "setting '" << key << "' during runtime not allowed";
+        gu_throw_error(EPERM)
+            << "setting '" << key << "' during runtime not allowed";
+    }
+
+    if (key == Param::trace_dump)
+    {
+        /* this is a command rather than a setting, so act on every set */
+        gu::EventTrace::dump(value);
+        config_.set(key, value);
+        return;
+    }
+
     try
     {
         if (config_.get(key) == value) return;
@@ -92,11 +92,21 @@ typedef enum status_vars
     STATS_LOCAL_SEND_QUEUE_MAX,
     STATS_LOCAL_SEND_QUEUE_MIN,
     STATS_LOCAL_SEND_QUEUE_AVG,
+    STATS_LOCAL_SEND_QUEUE_FAST,
+    STATS_LOCAL_SEND_QUEUE_FAST_MAX,
+    STATS_LOCAL_SEND_QUEUE_FAST_MIN,
+    STATS_LOCAL_SEND_QUEUE_FAST_AVG,
+    STATS_LOCAL_SEND_QUEUE_BULK,
+    STATS_LOCAL_SEND_QUEUE_BULK_MAX,
+    STATS_LOCAL_SEND_QUEUE_BULK_MIN,
+    STATS_LOCAL_SEND_QUEUE_BULK_AVG,
     STATS_LOCAL_RECV_QUEUE,
     STATS_LOCAL_RECV_QUEUE_MAX,
     STATS_LOCAL_RECV_QUEUE_MIN,
     STATS_LOCAL_RECV_QUEUE_AVG,
     STATS_LOCAL_CACHED_DOWNTO,
+    STATS_LOCAL_CACHED_RELEASE_BACKLOG,
+    STATS_LOCAL_CACHED_RELEASE_NS,
     STATS_FC_PAUSED_NS,
     STATS_FC_PAUSED_AVG,
     STATS_FC_SENT,
@@ -137,11 +147,21 @@ static const struct wsrep_stats_var wsrep_stats[STATS_MAX + 1] =
     { "local_send_queue_max",     WSREP_VAR_INT64,  { 0 }  },
     { "local_send_queue_min",     WSREP_VAR_INT64,  { 0 }  },
     { "local_send_queue_avg",     WSREP_VAR_DOUBLE, { 0 }  },
+    { "local_send_queue_fast",    WSREP_VAR_INT64,  { 0 }  },
+    { "local_send_queue_fast_max",WSREP_VAR_INT64,  { 0 }  },
+    { "local_send_queue_fast_min",WSREP_VAR_INT64,  { 0 }  },
+    { "local_send_queue_fast_avg",WSREP_VAR_DOUBLE, { 0 }  },
+    { "local_send_queue_bulk",    WSREP_VAR_INT64,  { 0 }  },
+    { "local_send_queue_bulk_max",WSREP_VAR_INT64,  { 0 }  },
+    { "local_send_queue_bulk_min",WSREP_VAR_INT64,  { 0 }  },
+    { "local_send_queue_bulk_avg",WSREP_VAR_DOUBLE, { 0 }  },
     { "local_recv_queue",         WSREP_VAR_INT64,  { 0 }  },
     { "local_recv_queue_max",     WSREP_VAR_INT64,  { 0 }  },
     { "local_recv_queue_min",     WSREP_VAR_INT64,  { 0 }  },
     { "local_recv_queue_avg",     WSREP_VAR_DOUBLE, { 0 }  },
     { "local_cached_downto",      WSREP_VAR_INT64,  { 0 }  },
+    { "local_cached_release_backlog", WSREP_VAR_INT64, { 0 } },
+    { "local_cached_release_ns",  WSREP_VAR_INT64,  { 0 }  },
     { "flow_control_paused_ns",   WSREP_VAR_INT64,  { 0 }  },
     { "flow_control_paused",      WSREP_VAR_DOUBLE, { 0 }  },
     { "flow_control_sent",        WSREP_VAR_INT64,  { 0 }  },
@@ -205,11 +225,26 @@ galera::ReplicatorSMM::stats_get() const
     sv[STATS_LOCAL_SEND_QUEUE_MAX].value._int64  = stats.send_q_len_max;
     sv[STATS_LOCAL_SEND_QUEUE_MIN].value._int64  = stats.send_q_len_min;
     sv[STATS_LOCAL_SEND_QUEUE_AVG].value._double = stats.send_q_len_avg;
+    sv[STATS_LOCAL_SEND_QUEUE_FAST].value._int64 = stats.send_q_fast_len;
+    sv[STATS_LOCAL_SEND_QUEUE_FAST_MAX].value._int64 = stats.send_q_fast_len_max;
+    sv[STATS_LOCAL_SEND_QUEUE_FAST_MIN].value._int64 = stats.send_q_fast_len_min;
+    sv[STATS_LOCAL_SEND_QUEUE_FAST_AVG].value._double = stats.send_q_fast_len_avg;
+    sv[STATS_LOCAL_SEND_QUEUE_BULK].value._int64 = stats.send_q_bulk_len;
+    sv[STATS_LOCAL_SEND_QUEUE_BULK_MAX].value._int64 = stats.send_q_bulk_len_max;
+    sv[STATS_LOCAL_SEND_QUEUE_BULK_MIN].value._int64 = stats.send_q_bulk_len_min;
+    sv[STATS_LOCAL_SEND_QUEUE_BULK_AVG].value._double = stats.send_q_bulk_len_avg;
     sv[STATS_LOCAL_RECV_QUEUE    ].value._int64  = stats.recv_q_len;
     sv[STATS_LOCAL_RECV_QUEUE_MAX].value._int64  = stats.recv_q_len_max;
     sv[STATS_LOCAL_RECV_QUEUE_MIN].value._int64  = stats.recv_q_len_min;
     sv[STATS_LOCAL_RECV_QUEUE_AVG].value._double = stats.recv_q_len_avg;
     sv[STATS_LOCAL_CACHED_DOWNTO ].value._int64  = gcache_.seqno_min();
+    {
+        int64_t   backlog;
+        long long release_ns;
+        gcache_.seqno_release_stats(backlog, release_ns);
+        sv[STATS_LOCAL_CACHED_RELEASE_BACKLOG].value._int64 = backlog;
+        sv[STATS_LOCAL_CACHED_RELEASE_NS     ].value._int64 = release_ns;
+    }
     sv[STATS_FC_PAUSED_NS        ].value._int64  = stats.fc_paused_ns;
     sv[STATS_FC_PAUSED_AVG       ].value._double = stats.fc_paused_avg;
     sv[STATS_FC_SENT             ].value._int64  = stats.fc_sent;
@@ -11,6 +11,7 @@
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 #include <sys/file.h>
+#include <unistd.h>
 
 namespace galera
 {
@@ -18,14 +19,24 @@ namespace galera
 #define VERSION "2.1"
 #define MAX_SIZE 256
 
-SavedState::SavedState  (const std::string& file) :
+gu::datetime::Period const SavedState::SYNC_PERIOD(100*gu::datetime::MSec);
+
+SavedState::SavedState  (const std::string&          file,
+                         const gu::datetime::Period& sync_period) :
     fs_           (0),
     uuid_         (WSREP_UUID_UNDEFINED),
     seqno_        (WSREP_SEQNO_UNDEFINED),
     unsafe_       (0),
     corrupt_      (false),
     mtx_          (),
+    cond_         (),
+    thd_          (),
+    sync_period_  (sync_period),
+    thd_running_  (false),
+    pending_      (false),
+    exit_         (false),
     written_uuid_ (uuid_),
+    written_seqno_(seqno_),
     current_len_  (0),
     total_marks_  (0),
     total_locks_  (0),
@@ -51,6 +62,21 @@ SavedState::SavedState  (const std::string& file) :
             << "'. Check permissions and/or disk space.";
     }
 
+    if (sync_period_.get_nsecs() > 0)
+    {
+        int const err(gu_thread_create (&thd_, NULL, writer_thd, this));
+
+        if (err)
+        {
+            log_warn << "Failed to start state writer thread: " << err
+                     << " (" << strerror(err) << "). Writing synchronously.";
+        }
+        else
+        {
+            thd_running_ = true;
+        }
+    }
+
     // We take exclusive lock on state file in order to avoid possibility
     // of two Galera replicators sharing the same state file.
     if (flock(fileno(fs_), LOCK_EX|LOCK_NB))
@@ -114,7 +140,8 @@ SavedState::SavedState  (const std::string& file) :
     }
 #endif
 
-    written_uuid_ = uuid_;
+    written_uuid_  = uuid_;
+    written_seqno_ = seqno_;
 
     current_len_ = ftell (fs_);
     log_debug << "Initialized current_len_ to " << current_len_;
@@ -126,14 +153,31 @@ SavedState::SavedState  (const std::string& file) :
     {
         fs_ = freopen (file.c_str(), "w+", fs_); // truncate
         current_len_ = 0;
-        set (uuid_, seqno_);
+
+        gu::Lock lock(mtx_);
+        write_and_flush (uuid_, seqno_);
     }
 }
 
 SavedState::~SavedState ()
 {
+    if (thd_running_)
+    {
+        {
+            gu::Lock lock(mtx_);
+            exit_ = true;
+            cond_.signal();
+        }
+
+        gu_thread_join(thd_, NULL);
+    }
+
+    flush();
+
     if (fs_)
     {
+        fsync(fileno(fs_));
+
         if (flock(fileno(fs_), LOCK_UN) != 0)
         {
             log_error << "Could not unlock saved state file.";
@@ -160,17 +204,99 @@ SavedState::set (const wsrep_uuid_t& u, wsrep_seqno_t s)
 
     uuid_ = u;
     seqno_ = s;
+    pending_ = false;
 
+    /* always synchronous: callers (pause, non-primary, state transfer) rely
+     * on the position being on disk when this returns */
     if (0 == unsafe_())
-        write_and_flush (u, s);
+        write_and_flush (u, s, true);
     else
         log_debug << "Not writing state: unsafe counter is " << unsafe_();
 }
 
+void
+SavedState::flush()
+{
+    gu::Lock lock(mtx_);
+
+    if (pending_ && 0 == unsafe_() && !corrupt_)
+    {
+        write_and_flush (uuid_, seqno_);
+    }
+
+    pending_ = false;
+}
+
 /* the goal of unsafe_, written_uuid_, current_len_ below is
  * 1. avoid unnecessary mutex locks
  * 2. if locked - avoid unnecessary file writes
- * 3. if writing - avoid metadata operations, write over existing space */
+ * 3. if writing - avoid metadata operations, write over existing space
+ * 4. defer writes which carry no position over a file which holds none
+ *    either (e.g. mark_safe() after TO isolation while running): a crash
+ *    before the deferred write leaves the same information on disk, so those
+ *    can be coalesced and synced at most once per sync_period_. Any write
+ *    that records or revokes a valid seqno is done synchronously. */
+
+void
+SavedState::write_or_defer()
+{
+    if (written_uuid_ == uuid_ && written_seqno_ == seqno_)
+    {
+        pending_ = false;
+    }
+    else if (thd_running_ && seqno_ < 0 && written_seqno_ < 0)
+    {
+        if (!pending_)
+        {
+            pending_ = true;
+            cond_.signal();
+        }
+    }
+    else
+    {
+        write_and_flush (uuid_, seqno_);
+    }
+}
+
+void*
+SavedState::writer_thd(void* arg)
+{
+    SavedState* const st(static_cast<SavedState*>(arg));
+
+    gu::Lock lock(st->mtx_);
+
+    while (!st->exit_)
+    {
+        if (!st->pending_)
+        {
+            lock.wait(st->cond_);
+            continue;
+        }
+
+        /* let more updates accumulate before hitting the disk */
+        gu::datetime::Date const until(gu::datetime::Date::calendar() +
+                                       st->sync_period_);
+        try
+        {
+            while (st->pending_ && !st->exit_) lock.wait(st->cond_, until);
+        }
+        catch (gu::Exception& e)
+        {
+            if (ETIMEDOUT != e.get_errno()) throw;
+        }
+
+        if (st->exit_) break; // destructor will flush
+
+        if (st->pending_ && 0 == st->unsafe_() && !st->corrupt_)
+        {
+            st->write_and_flush (st->uuid_, st->seqno_);
+        }
+
+        st->pending_ = false;
+    }
+
+    return NULL;
+}
 
 void
 SavedState::mark_unsafe()
@@ -183,7 +309,9 @@ SavedState::mark_unsafe()
 
         assert (unsafe_() > 0);
 
-        if (written_uuid_ != WSREP_UUID_UNDEFINED)
+        /* a file which holds no valid seqno can't be made any less safe:
+         * leave it (and a deferred write of it) alone */
+        if (written_seqno_ >= 0)
         {
             write_and_flush (WSREP_UUID_UNDEFINED, WSREP_SEQNO_UNDEFINED);
         }
@@ -207,7 +335,7 @@ SavedState::mark_safe()
             assert(false == corrupt_);
             /* this will write down proper seqno if set() was called too early
              * (in unsafe state) */
-            write_and_flush (uuid_, seqno_);
+            write_or_defer();
         }
     }
 }
@@ -226,12 +354,14 @@ SavedState::mark_corrupt()
     uuid_  = WSREP_UUID_UNDEFINED;
     seqno_ = WSREP_SEQNO_UNDEFINED;
     corrupt_ = true;
+    pending_ = false;
 
     write_and_flush (WSREP_UUID_UNDEFINED, WSREP_SEQNO_UNDEFINED);
 }
 
 void
-SavedState::write_and_flush(const wsrep_uuid_t& u, const wsrep_seqno_t s)
+SavedState::write_and_flush(const wsrep_uuid_t& u, const wsrep_seqno_t s,
+                            bool const sync)
 {
     assert (current_len_ <= MAX_SIZE);
 
@@ -255,9 +385,12 @@ SavedState::write_and_flush(const wsrep_uuid_t& u, const wsrep_seqno_t s)
         rewind(fs_);
         fwrite(buf, write_size, 1, fs_);
         fflush(fs_);
+        if (sync) fsync(fileno(fs_));
 
-        current_len_ = state_len;
-        written_uuid_ = u;
+        current_len_   = state_len;
+        written_uuid_  = u;
+        written_seqno_ = s;
+        pending_       = false;
         ++total_writes_;
     }
     else
@@ -8,6 +8,7 @@
 #include "gu_atomic.hpp"
 #include "gu_mutex.hpp"
 #include "gu_lock.hpp"
+#include "gu_datetime.hpp"
 
 #include "wsrep_api.h"
 
@@ -21,7 +22,16 @@ class SavedState
 {
 public:
 
-    SavedState  (const std::string& file);
+    /*!
+     * @param file        state file name
+     * @param sync_period mark_safe() writes that carry no valid seqno over
+     *                    a file which holds none either are coalesced and
+     *                    written at most once per this period by a background
+     *                    thread. Zero means write through. set() and writes
+     *                    of a valid seqno are always synchronous.
+     */
+    SavedState  (const std::string& file,
+                 const gu::datetime::Period& sync_period = SYNC_PERIOD);
     ~SavedState ();
 
     void get (wsrep_uuid_t& u, wsrep_seqno_t& s);
@@ -31,6 +41,11 @@ public:
     void mark_safe();
     void mark_corrupt();
 
+    /*! writes down pending deferred state, if any */
+    void flush();
+
+    static gu::datetime::Period const SYNC_PERIOD;
+
     void stats(long& marks, long& locks, long& writes)
     {
         marks  = total_marks_();
@@ -49,13 +64,25 @@ private:
     /* this mutex is needed because mark_safe() and mark_corrupt() will be
      * called outside local monitor, so race is possible */
     gu::Mutex        mtx_;
+    gu::Cond         cond_;
+    gu_thread_t      thd_;
+    gu::datetime::Period const sync_period_;
+    bool             thd_running_;
+    bool             pending_; // in-memory state awaits deferred write
+    bool             exit_;
     wsrep_uuid_t     written_uuid_;
+    wsrep_seqno_t    written_seqno_;
     ssize_t          current_len_;
     gu::Atomic<long> total_marks_;
     long             total_locks_;
     long             total_writes_;
 
-    void write_and_flush (const wsrep_uuid_t& u, const wsrep_seqno_t s);
+    /* sync: also fsync() the file, otherwise only flushed to the OS */
+    void write_and_flush (const wsrep_uuid_t& u, const wsrep_seqno_t s,
+                          bool sync = false);
+    void write_or_defer  ();
+
+    static void* writer_thd (void* arg);
 
     SavedState (const SavedState&);
     SavedState& operator=(const SavedState&);
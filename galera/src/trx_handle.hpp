@@ -52,6 +52,28 @@ namespace galera
 
         static const Params Defaults;
 
+        /*! @return trx protocol version used with replication protocol
+         *          version repl_proto_ver, or -1 if it is not supported */
+        static int version_for_repl_proto(int const repl_proto_ver)
+        {
+            switch (repl_proto_ver)
+            {
+            case 1:
+            case 2:
+                return 1;
+            case 3:
+            case 4:
+                return 2;
+            case 5:
+            case 6:
+            case 7:
+            case 8:
+                return 3;
+            }
+
+            return -1;
+        }
+
         enum Flags
         {
             F_COMMIT      = 1 << 0,
@@ -304,6 +326,64 @@ namespace galera
             depends_seqno_ = seqno_lt;
         }
 
+        /*
+         * Exact applying dependencies, a finer alternative to depends_seqno
+         * (which is the greatest of them): trx may be applied as soon as
+         * everything up to deps_floor() and every seqno in dep(i) have been.
+         * Not tracked unless certification is configured to.
+         */
+        static int const MAX_DEPS = 8;
+
+        void track_deps(wsrep_seqno_t const floor)
+        {
+            deps_floor_ = floor;
+            deps_count_ = 0;
+        }
+
+        void untrack_deps() { deps_count_ = -1; }
+
+        bool deps_tracked() const { return deps_count_ >= 0; }
+
+        void raise_deps_floor(wsrep_seqno_t const seqno)
+        {
+            if (seqno > deps_floor_) deps_floor_ = seqno;
+        }
+
+        void add_dep(wsrep_seqno_t const seqno)
+        {
+            if (!deps_tracked() || seqno <= deps_floor_) return;
+
+            for (int i(0); i < deps_count_; ++i)
+            {
+                if (deps_[i] == seqno) return;
+            }
+
+            if (gu_unlikely(MAX_DEPS == deps_count_))
+            {
+                /* fold the earliest dependency into the floor */
+                int min(0);
+                for (int i(1); i < deps_count_; ++i)
+                {
+                    if (deps_[i] < deps_[min]) min = i;
+                }
+
+                if (seqno < deps_[min])
+                {
+                    deps_floor_ = seqno;
+                    return;
+                }
+
+                deps_floor_ = deps_[min];
+                deps_[min]  = deps_[--deps_count_];
+            }
+
+            deps_[deps_count_++] = seqno;
+        }
+
+        wsrep_seqno_t deps_floor() const { return deps_floor_; }
+        int           deps_count() const { return deps_count_; }
+        wsrep_seqno_t dep(int i)   const { return deps_[i];    }
+
         State state() const { return state_(); }
         void set_state(State state) { state_.shift_to(state); }
 
@@ -627,6 +707,9 @@ namespace galera
             global_seqno_      (WSREP_SEQNO_UNDEFINED),
             last_seen_seqno_   (WSREP_SEQNO_UNDEFINED),
             depends_seqno_     (WSREP_SEQNO_UNDEFINED),
+            deps_floor_        (WSREP_SEQNO_UNDEFINED),
+            deps_count_        (-1),
+            deps_              (),
             timestamp_         (),
             write_set_         (Defaults.version_),
             write_set_in_      (),
@@ -666,6 +749,9 @@ namespace galera
             global_seqno_      (WSREP_SEQNO_UNDEFINED),
             last_seen_seqno_   (WSREP_SEQNO_UNDEFINED),
             depends_seqno_     (WSREP_SEQNO_UNDEFINED),
+            deps_floor_        (WSREP_SEQNO_UNDEFINED),
+            deps_count_        (-1),
+            deps_              (),
             timestamp_         (gu_time_calendar()),
             write_set_         (params.version_),
             write_set_in_      (),
@@ -728,6 +814,9 @@ namespace galera
         wsrep_seqno_t          global_seqno_;
         wsrep_seqno_t          last_seen_seqno_;
         wsrep_seqno_t          depends_seqno_;
+        wsrep_seqno_t          deps_floor_;
+        int                    deps_count_;
+        wsrep_seqno_t          deps_[MAX_DEPS];
         int64_t                timestamp_;
         WriteSet               write_set_;
         WriteSetIn             write_set_in_;
@@ -20,6 +20,7 @@
 
 #include "gu_serialize.hpp"
 #include "gu_vector.hpp"
+#include "gu_thread_affinity.hpp"
 
 #include <vector>
 #include <string>
@@ -817,6 +818,7 @@ namespace galera
         static void* checksum_thread (void* arg)
         {
             WriteSetIn* ws(reinterpret_cast<WriteSetIn*>(arg));
+            gu::ThreadAffinity::apply(gu::ThreadAffinity::CHECKSUM);
             ws->checksum();
             return NULL;
         }
@@ -17,6 +17,7 @@ extern Suite* key_set_suite();
 extern Suite* write_set_ng_suite();
 extern Suite* write_set_suite();
 extern Suite* trx_handle_suite();
+extern Suite* monitor_suite();
 extern Suite* service_thd_suite();
 extern Suite* ist_suite();
 extern Suite* saved_state_suite();
@@ -28,6 +29,7 @@ static suite_creator_t suites[] =
     write_set_ng_suite,
     write_set_suite,
     trx_handle_suite,
+    monitor_suite,
     service_thd_suite,
     ist_suite,
     saved_state_suite,
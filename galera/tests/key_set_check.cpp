@@ -7,6 +7,7 @@
 
 #include "test_key.hpp"
 #include "../src/key_set.hpp"
+#include "../src/key_filter.hpp"
 
 #include "gu_logger.hpp"
 #include "gu_hexdump.hpp"
@@ -33,15 +34,15 @@ static size_t version_to_hash_size (KeySet::Version const ver)
     case KeySet::FLAT16A: return 16;
     case KeySet::FLAT8:   fail ("FLAT8 is not supported by test");
     case KeySet::FLAT8A:  return 8;
+    case KeySet::FLAT16SA:return 16;
     default:              fail ("Unsupported KeySet verison: %d", ver);
     }
 
     abort();
 }
 
-START_TEST (ver0)
+static void test_ver (KeySet::Version const tk_ver)
 {
-    KeySet::Version const tk_ver(KeySet::FLAT16A);
     size_t const base_size(version_to_hash_size(tk_ver));
 
     gu::byte_t reserved[1024];
@@ -235,12 +236,122 @@ START_TEST (ver0)
 
     fail_if(0 == shared);
 }
+
+START_TEST (ver0)
+{
+    test_ver(KeySet::FLAT16A);
+}
+END_TEST
+
+START_TEST (ver_fast)
+{
+    test_ver(KeySet::FLAT16SA);
+}
+END_TEST
+
+/* returns the last key part of a single key appended to a key set of
+ * version ver */
+static KeySet::KeyPart
+last_part (std::vector<gu::byte_t>& in, KeySet::Version const ver,
+           TestKey& tk)
+{
+    gu::byte_t reserved[1024];
+    TestBaseName const str("key_set_test");
+    KeySetOut kso (reserved, sizeof(reserved), str, ver);
+
+    kso.append(tk());
+
+    KeySetOut::GatherVector out;
+    out->reserve(kso.page_count());
+    kso.gather(out);
+
+    in.clear();
+    for (size_t i(0); i < out->size(); ++i)
+    {
+        const gu::byte_t* ptr(reinterpret_cast<const gu::byte_t*>(out[i].ptr));
+        in.insert (in.end(), ptr, ptr + out[i].size);
+    }
+
+    KeySetIn ksi (kso.version(), in.data(), in.size());
+    ksi.checksum();
+
+    KeySet::KeyPart ret;
+    for (int i(0); i < ksi.count(); ++i) ret = ksi.next();
+
+    fail_if (ret.version() != ver);
+
+    return ret;
+}
+
+START_TEST (fast_hash)
+{
+    fail_if (KeySet::version(KeySet::FLAT8,    true)  != KeySet::FLAT8S);
+    fail_if (KeySet::version(KeySet::FLAT16A,  true)  != KeySet::FLAT16SA);
+    fail_if (KeySet::version(KeySet::FLAT16S,  false) != KeySet::FLAT16);
+    fail_if (KeySet::version(KeySet::FLAT16S,  true)  != KeySet::FLAT16S);
+    fail_if (KeySet::version("flat8s") != KeySet::FLAT8S);
+
+    TestKey tk0(KeySet::FLAT16S, EXCLUSIVE, false, "a0", "a1");
+    TestKey tk1(KeySet::FLAT16S, EXCLUSIVE, false, "a0", "b1");
+    TestKey tk2(KeySet::FLAT16S, EXCLUSIVE, false, "a1", "a0");
+
+    std::vector<gu::byte_t> b8, b16, b16_0;
+
+    KeySet::KeyPart const kp8 (last_part(b8,    KeySet::FLAT8S,  tk0));
+    KeySet::KeyPart const kp16(last_part(b16,   KeySet::FLAT16S, tk0));
+
+    /* 8-byte hash must be a prefix of 16-byte one */
+    fail_if (!kp8.matches(kp16));
+    fail_if (!kp16.matches(kp8));
+    fail_if (kp8.hash() != kp16.hash());
+
+    KeySet::KeyPart const kp1(last_part(b16_0, KeySet::FLAT16S, tk1));
+    fail_if (kp16.matches(kp1));
+
+    /* parts must be chained in order */
+    KeySet::KeyPart const kp2(last_part(b16_0, KeySet::FLAT16S, tk2));
+    fail_if (kp16.matches(kp2));
+}
+END_TEST
+
+START_TEST (key_filter)
+{
+    KeyFilter kf(8);
+    size_t const n(32);
+
+    for (size_t i(0); i < n; ++i) fail_if (kf.may_contain(i * 1021));
+
+    for (size_t i(0); i < n; ++i) kf.insert(i * 1021);
+    kf.insert(0); // duplicate
+
+    for (size_t i(0); i < n; ++i) fail_if (!kf.may_contain(i * 1021));
+
+    for (size_t i(1); i < n; ++i) kf.erase(i * 1021);
+
+    fail_if (!kf.may_contain(0));
+    kf.erase(0);
+    fail_if (!kf.may_contain(0));
+    kf.erase(0);
+
+    for (size_t i(0); i < n; ++i) fail_if (kf.may_contain(i * 1021));
+
+    /* saturated counters stay set */
+    for (size_t i(0); i < 300; ++i) kf.insert(7);
+    for (size_t i(0); i < 300; ++i) kf.erase(7);
+    fail_if (!kf.may_contain(7));
+
+    kf.clear();
+    fail_if (kf.may_contain(7));
+}
 END_TEST
 
 Suite* key_set_suite ()
 {
     TCase* t = tcase_create ("KeySet");
     tcase_add_test (t, ver0);
+    tcase_add_test (t, ver_fast);
+    tcase_add_test (t, fast_hash);
+    tcase_add_test (t, key_filter);
     tcase_set_timeout(t, 60);
 
     Suite* s = suite_create ("KeySet");
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#include "replicator_smm.hpp" // ReplicatorSMM::ApplyOrder
+#include "monitor.hpp"
+
+#include <gu_lock.hpp>
+
+#include <pthread.h>
+#include <unistd.h>
+#include <check.h>
+
+using namespace galera;
+
+typedef ReplicatorSMM::ApplyOrder ApplyOrder;
+
+static TrxHandle*
+slave_trx(TrxHandle::SlavePool& sp, wsrep_seqno_t const seqno)
+{
+    TrxHandle* const trx(TrxHandle::New(sp));
+    trx->set_received(0, seqno, seqno);
+    return trx;
+}
+
+namespace
+{
+    class Applier
+    {
+    public:
+
+        Applier(Monitor<ApplyOrder>& mon, ApplyOrder& ao, TrxHandle& trx)
+            : mon_(mon), ao_(ao), trx_(trx), mutex_(), entered_(false) {}
+
+        void apply()
+        {
+            trx_.lock();
+            mon_.enter(ao_);
+            {
+                gu::Lock lock(mutex_);
+                entered_ = true;
+            }
+            mon_.leave(ao_);
+            trx_.unlock();
+        }
+
+        bool entered()
+        {
+            gu::Lock lock(mutex_);
+            return entered_;
+        }
+
+    private:
+
+        Monitor<ApplyOrder>& mon_;
+        ApplyOrder&          ao_;
+        TrxHandle&           trx_;
+        gu::Mutex            mutex_;
+        bool                 entered_;
+    };
+}
+
+extern "C" void* applier_thd(void* arg)
+{
+    static_cast<Applier*>(arg)->apply();
+    return 0;
+}
+
+static void
+enter(Monitor<ApplyOrder>& mon, ApplyOrder& ao, TrxHandle& trx)
+{
+    trx.lock();
+    mon.enter(ao);
+    trx.unlock();
+}
+
+/* a trx with exact dependencies enters the apply monitor as soon as they
+ * have left, even if earlier trxs are still applying */
+START_TEST(test_exact_deps)
+{
+    TrxHandle::SlavePool sp(sizeof(TrxHandle), 4, "test_exact_deps");
+    Monitor<ApplyOrder> mon;
+
+    mon.set_wake_any(true);
+    mon.set_initial_position(0);
+
+    TrxHandle* trx[4];
+    for (int i(0); i < 4; ++i)
+    {
+        trx[i] = slave_trx(sp, i + 1);
+        trx[i]->set_depends_seqno(0);
+        trx[i]->track_deps(0);
+    }
+
+    /* seqno 4 depends only on seqno 2 */
+    trx[3]->set_depends_seqno(2);
+    trx[3]->add_dep(2);
+
+    ApplyOrder ao1(*trx[0], &mon);
+    ApplyOrder ao2(*trx[1], &mon);
+    ApplyOrder ao3(*trx[2], &mon);
+    ApplyOrder ao4(*trx[3], &mon);
+
+    enter(mon, ao1, *trx[0]);
+    enter(mon, ao2, *trx[1]);
+    enter(mon, ao3, *trx[2]);
+
+    Applier applier(mon, ao4, *trx[3]);
+    pthread_t thd;
+    fail_if(pthread_create(&thd, 0, applier_thd, &applier));
+
+    usleep(100000);
+    fail_if(applier.entered(), "entered before its dependency left");
+
+    /* out of order leave of the dependency lets seqno 4 in while seqnos
+     * 1 and 3 are still applying */
+    mon.leave(ao2);
+
+    for (int i(0); i < 500 && !applier.entered(); ++i) usleep(10000);
+    bool const entered(applier.entered());
+
+    mon.leave(ao3);
+    mon.leave(ao1);
+    pthread_join(thd, 0);
+
+    fail_unless(entered, "did not enter after its dependency left");
+    fail_unless(mon.last_left() == 4);
+
+    for (int i(0); i < 4; ++i) trx[i]->unref();
+}
+END_TEST
+
+Suite* monitor_suite()
+{
+    Suite* s = suite_create("monitor");
+    TCase* tc;
+
+    tc = tcase_create("test_exact_deps");
+    tcase_add_test(tc, test_exact_deps);
+    tcase_set_timeout(tc, 20);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
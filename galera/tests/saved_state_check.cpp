@@ -10,6 +10,9 @@
 #include <errno.h>
 #include <pthread.h>
 
+#include <fstream>
+#include <sstream>
+
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 
@@ -202,6 +205,149 @@ START_TEST(test_corrupt)
 }
 END_TEST
 
+/* reads seqno directly from the file, bypassing SavedState and its lock */
+static wsrep_seqno_t
+file_seqno()
+{
+    std::ifstream ifs(fname);
+    std::string   line;
+    wsrep_seqno_t ret(WSREP_SEQNO_UNDEFINED - 1);
+
+    while (getline(ifs, line), ifs.good())
+    {
+        std::istringstream istr(line);
+        std::string        param;
+
+        istr >> param;
+
+        if (param == "seqno:") istr >> ret;
+    }
+
+    return ret;
+}
+
+START_TEST(test_deferred)
+{
+    unlink (fname);
+
+    wsrep_uuid_t  uuid;
+    gu_uuid_from_string("b2c01654-8dfe-11e1-0800-a834d641cfb5",
+                        to_gu_uuid(uuid));
+
+    static int const max_seqno(1000);
+    long marks, locks, writes, writes0;
+
+    {
+        SavedState st(fname);
+
+        st.set(uuid, WSREP_SEQNO_UNDEFINED);
+        st.stats(marks, locks, writes0);
+
+        /* TO isolation while running: nothing but uuid to write down */
+        for (int i = 1; i <= max_seqno; ++i)
+        {
+            st.mark_unsafe();
+            st.mark_safe();
+        }
+
+        st.stats(marks, locks, writes);
+        fail_if (writes - writes0 > 10, "Too many writes: %ld",
+                 writes - writes0);
+
+        st.flush();
+        fail_if (file_seqno() != WSREP_SEQNO_UNDEFINED);
+
+        /* position is on disk as soon as set() returns */
+        st.set(uuid, max_seqno);
+        fail_if (file_seqno() != max_seqno, "Expected seqno %d on disk, "
+                 "found %" PRId64, max_seqno, file_seqno());
+
+        /* valid seqno on disk must be revoked synchronously */
+        st.mark_unsafe();
+        fail_if (file_seqno() != WSREP_SEQNO_UNDEFINED,
+                 "Expected undefined seqno on disk, found %" PRId64,
+                 file_seqno());
+
+        /* and restored synchronously too */
+        st.mark_safe();
+        fail_if (file_seqno() != max_seqno, "Expected seqno %d on disk, "
+                 "found %" PRId64, max_seqno, file_seqno());
+
+        /* non-primary */
+        st.set(uuid, WSREP_SEQNO_UNDEFINED);
+        fail_if (file_seqno() != WSREP_SEQNO_UNDEFINED);
+
+        st.set(uuid, max_seqno); // pause
+        st.mark_unsafe();
+        st.mark_safe();
+    }
+
+    fail_if (file_seqno() != max_seqno, "Expected seqno %d on disk, "
+             "found %" PRId64, max_seqno, file_seqno());
+
+    {
+        /* write-through mode */
+        SavedState st(fname, gu::datetime::Period(0));
+
+        st.set(uuid, WSREP_SEQNO_UNDEFINED);
+        fail_if (file_seqno() != WSREP_SEQNO_UNDEFINED);
+
+        st.set(uuid, max_seqno + 1);
+        fail_if (file_seqno() != max_seqno + 1);
+    }
+
+    unlink (fname);
+}
+END_TEST
+
+START_TEST(test_burst)
+{
+    unlink (fname);
+
+    wsrep_uuid_t uuid1, uuid2;
+    gu_uuid_from_string("b2c01654-8dfe-11e1-0800-a834d641cfb5",
+                        to_gu_uuid(uuid1));
+    gu_uuid_from_string("c3d12765-8dfe-11e1-0800-a834d641cfb5",
+                        to_gu_uuid(uuid2));
+
+    long marks, locks, writes, writes0;
+
+    SavedState st(fname);
+    long long const period(SavedState::SYNC_PERIOD.get_nsecs());
+
+    st.set(uuid1, WSREP_SEQNO_UNDEFINED);
+
+    /* uuid change in unsafe state leaves a write to be done */
+    st.mark_unsafe();
+    st.set(uuid2, WSREP_SEQNO_UNDEFINED);
+
+    st.stats(marks, locks, writes0);
+    gu::datetime::Date const start(gu::datetime::Date::calendar());
+
+    for (int i = 0; i < 500; ++i)
+    {
+        st.mark_safe();
+        usleep (1000);
+        st.mark_unsafe();
+    }
+    st.mark_safe();
+
+    st.stats(marks, locks, writes);
+    long long const elapsed
+        ((gu::datetime::Date::calendar() - start).get_nsecs());
+    long const max_writes(elapsed / period + 1);
+
+    fail_if (writes - writes0 > max_writes, "%ld writes in %lld ms, "
+             "expected at most %ld", writes - writes0,
+             elapsed / gu::datetime::MSec, max_writes);
+
+    st.flush();
+    fail_if (file_seqno() != WSREP_SEQNO_UNDEFINED);
+
+    unlink (fname);
+}
+END_TEST
+
 #define WAIT_FOR(cond)                                                  \
     { int count = 1000; while (--count && !(cond)) { usleep (TEST_USLEEP); }}
 
@@ -214,6 +360,8 @@ Suite* saved_state_suite()
     tcase_add_test  (tc, test_basic);
     tcase_add_test  (tc, test_unsafe);
     tcase_add_test  (tc, test_corrupt);
+    tcase_add_test  (tc, test_deferred);
+    tcase_add_test  (tc, test_burst);
     tcase_set_timeout(tc, 120);
     suite_add_tcase (s, tc);
 
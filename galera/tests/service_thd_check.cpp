@@ -129,6 +129,101 @@ START_TEST(service_thd3)
 }
 END_TEST
 
+START_TEST(service_thd4)
+{
+    TestEnv env;
+    gcache::GCache& gcache(env.gcache());
+
+    static int const N = 1000;
+
+    for (int i = 1; i <= N; ++i)
+    {
+        void* const buf(gcache.malloc(64));
+        fail_if (buf == 0);
+        gcache.seqno_assign(buf, i, i - 1);
+    }
+
+    int64_t   backlog;
+    long long release_ns;
+
+    /* with the smallest slice each call should release a single buffer */
+    int calls(1);
+    while (!gcache.seqno_release(N/2, 1)) ++calls;
+    fail_if (calls < 2, "release of %d buffers took a single slice", N/2);
+
+    gcache.seqno_release_stats(backlog, release_ns);
+    fail_if (backlog != 0, "backlog = %" PRId64 ", expected 0", backlog);
+    fail_if (release_ns <= 0);
+
+    ServiceThd* thd = new ServiceThd(env.gcs(), gcache);
+    fail_if (thd == 0);
+
+    thd->release_seqno(N);
+    thd->flush();
+    WAIT_FOR((gcache.seqno_release_stats(backlog, release_ns), 0 == backlog));
+    fail_if (backlog != 0, "backlog = %" PRId64 ", expected 0", backlog);
+
+    /* released buffers are still cached for IST */
+    fail_if (gcache.seqno_min() != 1, "seqno_min = %" PRId64 ", expected 1",
+             gcache.seqno_min());
+
+    delete thd;
+}
+END_TEST
+
+START_TEST(service_thd5)
+{
+    TestEnv env;
+    gcache::GCache& gcache(env.gcache());
+
+    /* enough buffers to take more than one release slice */
+    static int const N = 30000;
+
+    for (int i = 1; i <= N; ++i)
+    {
+        void* const buf(gcache.malloc(16));
+        fail_if (buf == 0);
+        gcache.seqno_assign(buf, i, i - 1);
+    }
+
+    ServiceThd* thd = new ServiceThd(env.gcs(), gcache);
+    fail_if (thd == 0);
+
+    int64_t   backlog;
+    long long release_ns;
+
+    /* flush returns only after all slices of the release are done */
+    thd->release_seqno(N/2);
+    thd->flush();
+    gcache.seqno_release_stats(backlog, release_ns);
+    fail_if (backlog != 0, "backlog = %" PRId64 " after flush", backlog);
+
+    /* release of the old history is not continued after reset */
+    thd->release_seqno(N);
+    for (int i = 0; i < 100000 && 0 == backlog; ++i)
+    {
+        usleep(10); // until release has started
+        gcache.seqno_release_stats(backlog, release_ns);
+    }
+    thd->reset();
+    gcache.seqno_release(N); // the rest is released by the caller
+    gcache.seqno_reset();
+
+    for (int i = 1; i <= 10; ++i) // new history
+    {
+        void* const buf(gcache.malloc(16));
+        fail_if (buf == 0);
+        gcache.seqno_assign(buf, i, i - 1);
+    }
+
+    thd->flush();
+    gcache.seqno_release_stats(backlog, release_ns);
+    fail_if (backlog != 0, "backlog = %" PRId64 " after reset", backlog);
+
+    delete thd;
+}
+END_TEST
+
 Suite* service_thd_suite()
 {
     Suite* s = suite_create ("service_thd");
@@ -138,6 +233,8 @@ Suite* service_thd_suite()
     tcase_add_test  (tc, service_thd1);
     tcase_add_test  (tc, service_thd2);
     tcase_add_test  (tc, service_thd3);
+    tcase_add_test  (tc, service_thd4);
+    tcase_add_test  (tc, service_thd5);
     suite_add_tcase (s, tc);
 
     return s;
@@ -190,6 +190,58 @@ START_TEST(test_serialization)
 }
 END_TEST
 
+START_TEST(test_deps)
+{
+    TrxHandle::LocalPool tp(TrxHandle::LOCAL_STORAGE_SIZE, 4, "test_deps");
+    wsrep_uuid_t uuid = {{1, }};
+
+    TrxHandle* trx(TrxHandle::New(tp, TrxHandle::Defaults, uuid, -1, 1));
+
+    fail_if(trx->deps_tracked());
+    trx->add_dep(5);
+    fail_if(trx->deps_tracked());
+
+    trx->track_deps(10);
+    fail_unless(trx->deps_tracked());
+    trx->add_dep(-1);
+    trx->add_dep(10); // covered by floor
+    fail_unless(trx->deps_count() == 0);
+
+    trx->add_dep(20);
+    trx->add_dep(20); // duplicate
+    fail_unless(trx->deps_count() == 1);
+    fail_unless(trx->dep(0) == 20);
+
+    trx->raise_deps_floor(15);
+    trx->raise_deps_floor(12); // floor never goes down
+    fail_unless(trx->deps_floor() == 15);
+
+    for (int i(0); i < TrxHandle::MAX_DEPS - 1; ++i) trx->add_dep(30 + i);
+    fail_unless(trx->deps_count() == TrxHandle::MAX_DEPS);
+
+    // overflow folds the earliest dependency into the floor
+    trx->add_dep(100);
+    fail_unless(trx->deps_count() == TrxHandle::MAX_DEPS);
+    fail_unless(trx->deps_floor() == 20, "floor: %lld",
+                (long long)trx->deps_floor());
+
+    // unless the new one is the earliest
+    trx->add_dep(25);
+    fail_unless(trx->deps_floor() == 25);
+    fail_unless(trx->deps_count() == TrxHandle::MAX_DEPS);
+
+    for (int i(0); i < trx->deps_count(); ++i)
+    {
+        fail_if(trx->dep(i) <= trx->deps_floor());
+    }
+
+    trx->untrack_deps();
+    fail_if(trx->deps_tracked());
+
+    trx->unref();
+}
+END_TEST
+
 Suite* trx_handle_suite()
 {
     Suite* s = suite_create("trx_handle");
@@ -204,5 +256,9 @@ Suite* trx_handle_suite()
     tcase_add_test(tc, test_serialization);
     suite_add_tcase(s, tc);
 
+    tc = tcase_create("test_deps");
+    tcase_add_test(tc, test_deps);
+    suite_add_tcase(s, tc);
+
     return s;
 }
@@ -11,6 +11,7 @@
 #include "gcs_action_source.hpp"
 #include "galera_service_thd.hpp"
 
+#include <list>
 #include <cstdlib>
 #include <check.h>
 
@@ -410,7 +411,7 @@ START_TEST(test_cert_hierarchical_v1)
     TestEnv env;
     galera::Certification cert(env.conf(), env.thd());
     int const version(1);
-    cert.assign_initial_position(0, version);
+    cert.assign_initial_position(0, version, false);
     galera::TrxHandle::Params const trx_params("", version,KeySet::MAX_VERSION);
 
     mark_point();
@@ -532,7 +533,7 @@ START_TEST(test_cert_hierarchical_v2)
     TestEnv env;
     galera::Certification cert(env.conf(), env.thd());
 
-    cert.assign_initial_position(0, version);
+    cert.assign_initial_position(0, version, false);
     galera::TrxHandle::Params const trx_params("", version,KeySet::MAX_VERSION);
 
     mark_point();
@@ -584,7 +585,7 @@ START_TEST(test_trac_726)
     galera::TrxHandle::Params const trx_params("", version,KeySet::MAX_VERSION);
     wsrep_uuid_t uuid1 = {{1, }};
     wsrep_uuid_t uuid2 = {{2, }};
-    cert.assign_initial_position(0, version);
+    cert.assign_initial_position(0, version, false);
 
     mark_point();
 
@@ -643,6 +644,266 @@ START_TEST(test_trac_726)
 END_TEST
 
 
+static Certification::TestResult
+append_trx_v2(Certification& cert, const wsrep_uuid_t& uuid, wsrep_buf_t* key,
+              wsrep_seqno_t last_seen, wsrep_seqno_t seqno)
+{
+    const int version(2);
+    galera::TrxHandle::Params const trx_params("", version,KeySet::MAX_VERSION);
+
+    TrxHandle* trx(TrxHandle::New(lp, trx_params, uuid, 0, seqno));
+
+    trx->append_key(KeyData(version, key, 1, WSREP_KEY_EXCLUSIVE, true));
+    trx->set_last_seen_seqno(last_seen);
+    trx->flush(0);
+
+    const galera::MappedBuffer& wc(trx->write_set_collection());
+    gu::Buffer buf(wc.size());
+    std::copy(&wc[0], &wc[0] + wc.size(), &buf[0]);
+    trx->unref();
+    trx = TrxHandle::New(sp);
+    size_t offset(trx->unserialize(&buf[0], buf.size(), 0));
+    trx->append_write_set(&buf[0] + offset, buf.size() - offset);
+
+    trx->set_received(0, seqno, seqno);
+    Certification::TestResult const result(cert.append_trx(trx));
+    cert.set_trx_committed(trx);
+    trx->unref();
+
+    return result;
+}
+
+START_TEST(test_cert_purge)
+{
+    log_info << "test_cert_purge";
+
+    const int version(2);
+    TestEnv env;
+    galera::Certification cert(env.conf(), env.thd());
+    wsrep_uuid_t uuid1 = {{1, }};
+    wsrep_uuid_t uuid2 = {{2, }};
+    cert.assign_initial_position(0, version, false);
+
+    wsrep_buf_t key1 = {void_cast("1"), 1};
+    wsrep_buf_t key2 = {void_cast("2"), 1};
+
+    fail_unless(append_trx_v2(cert, uuid1, &key1, 0, 1) ==
+                Certification::TEST_OK);
+    fail_unless(append_trx_v2(cert, uuid1, &key2, 1, 2) ==
+                Certification::TEST_OK);
+
+    // key1 of trx 1 is still in the index
+    fail_unless(append_trx_v2(cert, uuid2, &key1, 0, 3) ==
+                Certification::TEST_FAILED);
+    // move safe to discard seqno past 1
+    fail_unless(append_trx_v2(cert, uuid1, &key2, 3, 4) ==
+                Certification::TEST_OK);
+
+    fail_unless(cert.purge_trxs_upto(1, true) == 1);
+
+    // index is purged by service thread
+    env.thd().flush();
+    fail_unless(append_trx_v2(cert, uuid2, &key1, 0, 5) ==
+                Certification::TEST_OK);
+}
+END_TEST
+
+
+/* if trx_out is given, certified trx is returned there and must be unref'ed
+ * by the caller */
+static Certification::TestResult
+append_trx_v3(Certification& cert, std::list<gu::Buffer>& actions,
+              const wsrep_uuid_t& uuid, const char* key,
+              wsrep_seqno_t last_seen, wsrep_seqno_t seqno,
+              KeySet::Version const key_format, TrxHandle** trx_out = 0)
+{
+    const int version(3);
+    galera::TrxHandle::Params const trx_params("", version, key_format);
+
+    TrxHandle* trx(TrxHandle::New(lp, trx_params, uuid, 0, seqno));
+
+    wsrep_buf_t const key_buf = { key, strlen(key) };
+    trx->append_key(KeyData(version, &key_buf, 1, WSREP_KEY_EXCLUSIVE, true));
+
+    galera::WriteSetNG::GatherVector bufs;
+    ssize_t const size(trx->write_set_out().gather(trx->source_id(),
+                                                   trx->conn_id(),
+                                                   trx->trx_id(),
+                                                   bufs));
+    trx->set_last_seen_seqno(last_seen);
+
+    // certification index refers to the action buffer, like it does to gcache
+    actions.push_back(gu::Buffer(size));
+    gu::Buffer& buf(actions.back());
+    gu::byte_t* p(&buf[0]);
+    for (size_t i(0); i < bufs->size(); ++i)
+    {
+        ::memcpy(p, bufs[i].ptr, bufs[i].size); p += bufs[i].size;
+    }
+    trx->unref();
+
+    trx = TrxHandle::New(sp);
+    trx->unserialize(&buf[0], buf.size(), 0);
+    trx->set_received(&buf[0], seqno, seqno);
+    Certification::TestResult const result(cert.append_trx(trx));
+    cert.set_trx_committed(trx);
+
+    if (trx_out)
+        *trx_out = trx;
+    else
+        trx->unref();
+
+    return result;
+}
+
+START_TEST(test_cert_key_hash)
+{
+    log_info << "test_cert_key_hash";
+
+    TestEnv env;
+    std::list<gu::Buffer> acts; // must outlive cert index
+    galera::Certification cert(env.conf(), env.thd());
+    wsrep_uuid_t uuid1 = {{1, }};
+    wsrep_uuid_t uuid2 = {{2, }};
+
+    // protocol 8: the index holds fast (Spooky) key hashes
+    cert.assign_initial_position(0, 3, true);
+
+    fail_unless(append_trx_v3(cert, acts, uuid1, "1", 0, 1, KeySet::FLAT16S) ==
+                Certification::TEST_OK);
+
+    // MMH3-hashed writeset built before the switch must not pass as
+    // non-conflicting against the fast hashes in the index
+    fail_unless(append_trx_v3(cert, acts, uuid2, "1", 0, 2, KeySet::FLAT16) ==
+                Certification::TEST_FAILED);
+    fail_unless(append_trx_v3(cert, acts, uuid2, "2", 0, 3, KeySet::FLAT16) ==
+                Certification::TEST_FAILED);
+
+    fail_unless(append_trx_v3(cert, acts, uuid2, "1", 0, 4, KeySet::FLAT16S) ==
+                Certification::TEST_FAILED);
+    fail_unless(append_trx_v3(cert, acts, uuid2, "2", 3, 5, KeySet::FLAT16S) ==
+                Certification::TEST_OK);
+}
+END_TEST
+
+
+START_TEST(test_cert_exact_deps)
+{
+    log_info << "test_cert_exact_deps";
+
+    TestEnv env;
+    env.conf().set(Certification::PARAM_EXACT_DEPS, "yes");
+    std::list<gu::Buffer> acts; // must outlive cert index
+    galera::Certification cert(env.conf(), env.thd());
+    wsrep_uuid_t uuid1 = {{1, }};
+    wsrep_uuid_t uuid2 = {{2, }};
+    TrxHandle* trx[3];
+
+    fail_unless(cert.exact_deps());
+    cert.assign_initial_position(0, 3, false);
+
+    fail_unless(append_trx_v3(cert, acts, uuid1, "1", 0, 1, KeySet::FLAT16,
+                              &trx[0]) == Certification::TEST_OK);
+    fail_unless(append_trx_v3(cert, acts, uuid1, "2", 0, 2, KeySet::FLAT16,
+                              &trx[1]) == Certification::TEST_OK);
+    /* conflicts with seqno 1 only */
+    fail_unless(append_trx_v3(cert, acts, uuid2, "1", 2, 3, KeySet::FLAT16,
+                              &trx[2]) == Certification::TEST_OK);
+
+    for (int i(0); i < 3; ++i)
+    {
+        fail_unless(trx[i]->deps_tracked());
+        fail_unless(trx[i]->deps_floor() == 0, "trx %d floor: %lld",
+                    i, (long long)trx[i]->deps_floor());
+    }
+
+    fail_unless(trx[0]->deps_count() == 0);
+    fail_unless(trx[1]->deps_count() == 0);
+
+    fail_unless(trx[2]->deps_count() == 1);
+    fail_unless(trx[2]->dep(0) == 1);
+    fail_unless(trx[2]->depends_seqno() == 1);
+
+    for (int i(0); i < 3; ++i) trx[i]->unref();
+}
+END_TEST
+
+
+/* certifies a preordered writeset, returns its depends seqno */
+static wsrep_seqno_t
+append_preordered(Certification& cert, std::list<gu::Buffer>& actions,
+                  const wsrep_uuid_t& source, wsrep_trx_id_t trx_id,
+                  wsrep_seqno_t seqno, int pa_range)
+{
+    const int version(3);
+    galera::TrxHandle::Params const trx_params("", version, KeySet::FLAT16);
+
+    TrxHandle* trx(TrxHandle::New(lp, trx_params, source, 0, trx_id));
+
+    trx->append_data("po", 2, WSREP_DATA_ORDERED, true);
+
+    galera::WriteSetNG::GatherVector bufs;
+    ssize_t const size(trx->write_set_out().gather(source, 0, trx_id, bufs));
+    trx->write_set_out().set_preordered(pa_range);
+
+    actions.push_back(gu::Buffer(size));
+    gu::Buffer& buf(actions.back());
+    gu::byte_t* p(&buf[0]);
+    for (size_t i(0); i < bufs->size(); ++i)
+    {
+        ::memcpy(p, bufs[i].ptr, bufs[i].size); p += bufs[i].size;
+    }
+    trx->unref();
+
+    trx = TrxHandle::New(sp);
+    trx->unserialize(&buf[0], buf.size(), 0);
+    trx->set_received(&buf[0], seqno, seqno);
+    fail_unless(trx->preordered());
+    fail_unless(cert.append_trx(trx) == Certification::TEST_OK);
+    wsrep_seqno_t const ret(trx->depends_seqno());
+    cert.set_trx_committed(trx);
+    trx->unref();
+
+    return ret;
+}
+
+START_TEST(test_cert_preordered)
+{
+    log_info << "test_cert_preordered";
+
+    TestEnv env;
+    std::list<gu::Buffer> acts; // must outlive cert index
+    galera::Certification cert(env.conf(), env.thd());
+    wsrep_uuid_t source = {{1, }};
+    wsrep_uuid_t uuid   = {{2, }};
+
+    cert.assign_initial_position(0, 3, false);
+
+    /* wsrep pa_range 0: may apply in parallel with one preceding preordered
+     * event (see WriteSetOut::set_preordered()) */
+    fail_unless(append_preordered(cert, acts, source, 1, 1, 0) == -1);
+
+    /* ordinary writesets interleaved with the preordered stream */
+    fail_unless(append_trx_v3(cert, acts, uuid, "1", 1, 2, KeySet::FLAT16) ==
+                Certification::TEST_OK);
+    fail_unless(append_trx_v3(cert, acts, uuid, "2", 2, 3, KeySet::FLAT16) ==
+                Certification::TEST_OK);
+
+    fail_unless(append_preordered(cert, acts, source, 2, 4, 0) == 0);
+
+    /* depends on preordered seqno 1 rather than on ordinary seqno 3 */
+    wsrep_seqno_t depends(append_preordered(cert, acts, source, 3, 5, 0));
+    fail_unless(depends == 1, "expected depends seqno 1, got %lld",
+                (long long)depends);
+
+    /* range wider than the kept history: conservative estimate from the
+     * earliest kept seqno 4 */
+    depends = append_preordered(cert, acts, source, 4, 6, 2);
+    fail_unless(depends == 2, "expected depends seqno 2, got %lld",
+                (long long)depends);
+}
+END_TEST
+
 Suite* write_set_suite()
 {
     Suite* s = suite_create("write_set");
@@ -683,5 +944,25 @@ Suite* write_set_suite()
     tcase_set_timeout(tc, 20);
     suite_add_tcase(s, tc);
 
+    tc = tcase_create("test_cert_purge");
+    tcase_add_test(tc, test_cert_purge);
+    tcase_set_timeout(tc, 20);
+    suite_add_tcase(s, tc);
+
+    tc = tcase_create("test_cert_key_hash");
+    tcase_add_test(tc, test_cert_key_hash);
+    tcase_set_timeout(tc, 20);
+    suite_add_tcase(s, tc);
+
+    tc = tcase_create("test_cert_exact_deps");
+    tcase_add_test(tc, test_cert_exact_deps);
+    tcase_set_timeout(tc, 20);
+    suite_add_tcase(s, tc);
+
+    tc = tcase_create("test_cert_preordered");
+    tcase_add_test(tc, test_cert_preordered);
+    tcase_set_timeout(tc, 20);
+    suite_add_tcase(s, tc);
+
     return s;
 }
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#include "gu_event_trace.hpp"
+#include "gu_serialize.hpp"
+#include "gu_logger.hpp"
+#include "gu_throw.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+gu::EventTrace::Record* gu::EventTrace::buf_  = NULL;
+uint64_t                gu::EventTrace::mask_ = 0;
+uint64_t                gu::EventTrace::pos_  = 0;
+
+/*
+ * Dump file format, all integers little-endian:
+ *
+ * header:  8 bytes magic, 4 bytes format version, 4 bytes record size,
+ *          8 bytes record count, 8 bytes realtime - monotonic clock offset
+ * records: 8 bytes time, 8 bytes seqno, 8 bytes ID, 4 bytes event
+ */
+static const char     DUMP_MAGIC[8] = { 'G','U','E','V','T','R','A','C' };
+static uint32_t const DUMP_VERSION(1);
+static size_t   const DUMP_HDR_SIZE(32);
+static uint32_t const DUMP_REC_SIZE(28);
+
+static const char* const event_names[gu::EventTrace::EVENT_MAX] =
+{
+    "gcs_send_begin",
+    "gcs_send_end",
+    "gcs_deliver",
+    "gcs_recv",
+    "cert_begin",
+    "cert_end",
+    "apply_enter",
+    "apply_leave",
+    "commit_enter",
+    "commit_leave",
+    "gcache_release"
+};
+
+const char*
+gu::EventTrace::event_str(uint32_t const event)
+{
+    return event < EVENT_MAX ? event_names[event] : "unknown";
+}
+
+void
+gu::EventTrace::init(size_t const size)
+{
+    if (0 == size) return;
+
+    if (buf_ != NULL)
+    {
+        if (size > mask_ + 1)
+        {
+            log_info << "Event trace already allocated for " << mask_ + 1
+                     << " records, ignoring new size " << size;
+        }
+        return;
+    }
+
+    size_t s(1);
+    while (s < size) s <<= 1;
+
+    Record* const buf(new Record[s]);
+    ::memset(buf, 0, s * sizeof(Record));
+    for (size_t i(0); i < s; ++i) buf[i].event = EVENT_MAX; // never recorded
+
+    mask_ = s - 1;
+    pos_  = 0;
+    buf_  = buf;
+
+    log_info << "Event trace enabled: " << s << " records, "
+             << s * sizeof(Record) << " bytes";
+}
+
+void
+gu::EventTrace::dump(const std::string& path)
+{
+    if (NULL == buf_)
+    {
+        gu_throw_error(EPERM) << "Event trace is disabled";
+    }
+
+    uint64_t end;
+    gu_atomic_get(&pos_, &end);
+
+    uint64_t const size(mask_ + 1);
+    uint64_t const begin(end > size ? end - size : 0);
+
+    FILE* const f(::fopen(path.c_str(), "wb"));
+
+    if (NULL == f)
+    {
+        int const err(errno);
+        gu_throw_error(err) << "Failed to open event trace dump file '"
+                            << path << '\'';
+    }
+
+    byte_t hdr[DUMP_HDR_SIZE];
+    ::memcpy(hdr, DUMP_MAGIC, sizeof(DUMP_MAGIC));
+    size_t off(sizeof(DUMP_MAGIC));
+    off = serialize4(DUMP_VERSION, hdr, sizeof(hdr), off);
+    off = serialize4(DUMP_REC_SIZE, hdr, sizeof(hdr), off);
+    off = serialize8(end - begin, hdr, sizeof(hdr), off);
+    off = serialize8(gu_time_calendar() - gu_time_monotonic(),
+                     hdr, sizeof(hdr), off);
+    assert(DUMP_HDR_SIZE == off);
+
+    bool ok(1 == ::fwrite(hdr, sizeof(hdr), 1, f));
+
+    for (uint64_t i(begin); ok && i < end; ++i)
+    {
+        const Record& r(buf_[i & mask_]);
+        byte_t rec[DUMP_REC_SIZE];
+
+        off = serialize8(r.time,  rec, sizeof(rec), 0);
+        off = serialize8(r.seqno, rec, sizeof(rec), off);
+        off = serialize8(r.id,    rec, sizeof(rec), off);
+        off = serialize4(r.event, rec, sizeof(rec), off);
+
+        ok = (1 == ::fwrite(rec, sizeof(rec), 1, f));
+    }
+
+    int const err(ok ? 0 : errno);
+
+    if (::fclose(f) && ok)
+    {
+        gu_throw_error(errno) << "Failed to close event trace dump file '"
+                              << path << '\'';
+    }
+
+    if (!ok)
+    {
+        gu_throw_error(err) << "Failed to write event trace dump file '"
+                            << path << '\'';
+    }
+
+    log_info << "Dumped " << end - begin << " trace events to '" << path
+             << '\'';
+}
+
+int64_t
+gu::EventTrace::load(const std::string& path, std::vector<Record>& records)
+{
+    FILE* const f(::fopen(path.c_str(), "rb"));
+
+    if (NULL == f)
+    {
+        int const err(errno);
+        gu_throw_error(err) << "Failed to open event trace dump file '"
+                            << path << '\'';
+    }
+
+    byte_t   hdr[DUMP_HDR_SIZE];
+    uint32_t ver(0);
+    uint32_t rec_size(0);
+    uint64_t count(0);
+    int64_t  offset(0);
+
+    if (1 == ::fread(hdr, sizeof(hdr), 1, f) &&
+        !::memcmp(hdr, DUMP_MAGIC, sizeof(DUMP_MAGIC)))
+    {
+        size_t off(sizeof(DUMP_MAGIC));
+        off = unserialize4(hdr, sizeof(hdr), off, ver);
+        off = unserialize4(hdr, sizeof(hdr), off, rec_size);
+        off = unserialize8(hdr, sizeof(hdr), off, count);
+        off = unserialize8(hdr, sizeof(hdr), off, offset);
+    }
+
+    if (DUMP_VERSION != ver || DUMP_REC_SIZE != rec_size)
+    {
+        ::fclose(f);
+        gu_throw_error(EINVAL) << "'" << path << "' is not an event trace "
+                               << "dump or has unsupported format";
+    }
+
+    records.clear();
+    records.reserve(count);
+
+    for (uint64_t i(0); i < count; ++i)
+    {
+        byte_t rec[DUMP_REC_SIZE];
+
+        if (1 != ::fread(rec, sizeof(rec), 1, f))
+        {
+            ::fclose(f);
+            gu_throw_error(EINVAL) << "Event trace dump '" << path
+                                   << "' is truncated at record " << i
+                                   << " of " << count;
+        }
+
+        Record r;
+        size_t off(0);
+        off = unserialize8(rec, sizeof(rec), off, r.time);
+        off = unserialize8(rec, sizeof(rec), off, r.seqno);
+        off = unserialize8(rec, sizeof(rec), off, r.id);
+        off = unserialize4(rec, sizeof(rec), off, r.event);
+
+        if (r.event < EVENT_MAX) records.push_back(r);
+    }
+
+    ::fclose(f);
+
+    return offset;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+/*!
+ * @file Process-wide ring buffer of timestamped replication pipeline events.
+ *
+ * Events are recorded per seqno by whatever thread passes the corresponding
+ * point of the pipeline, so that per-transaction critical paths can be
+ * reconstructed offline from a dump (see gu_event_trace_tool.cpp).
+ * Recording costs one atomic increment and one clock read, the ring is never
+ * locked and old records are simply overwritten.
+ */
+
+#ifndef _gu_event_trace_hpp_
+#define _gu_event_trace_hpp_
+
+#include "gu_atomic.h"
+#include "gu_time.h"
+#include "gu_macros.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace gu
+{
+    class EventTrace
+    {
+    public:
+
+        enum Event
+        {
+            GCS_SEND_BEGIN, /*!< replication requested, seqno unknown yet */
+            GCS_SEND_END,   /*!< replication returned to the sender */
+            GCS_DELIVER,    /*!< action delivered in total order by group */
+            GCS_RECV,       /*!< action taken from receive queue by applier */
+            CERT_BEGIN,
+            CERT_END,
+            APPLY_ENTER,
+            APPLY_LEAVE,
+            COMMIT_ENTER,
+            COMMIT_LEAVE,
+            GCACHE_RELEASE,
+            EVENT_MAX
+        };
+
+        static const char* event_str(uint32_t event);
+
+        struct Record
+        {
+            int64_t  time;  /*!< monotonic clock, ns */
+            int64_t  seqno; /*!< global seqno, -1 if not known yet */
+            uint64_t id;    /*!< transaction ID, 0 if not known */
+            uint32_t event;
+        };
+
+        /*!
+         * Allocates ring buffer for at least size records, 0 leaves tracing
+         * disabled. Takes effect only once per process and must be called
+         * before any events are recorded.
+         */
+        static void init(size_t size);
+
+        static bool enabled() { return buf_ != NULL; }
+
+        static void record(Event const e, int64_t const seqno,
+                           uint64_t const id = 0)
+        {
+            if (gu_likely(buf_ != NULL))
+            {
+                Record& r(buf_[gu_atomic_fetch_and_add(&pos_, 1) & mask_]);
+
+                r.time  = gu_time_monotonic();
+                r.seqno = seqno;
+                r.id    = id;
+                r.event = e;
+            }
+        }
+
+        /*!
+         * Writes records currently in the ring, oldest first, to a file.
+         * Events keep being recorded meanwhile, so records overwritten during
+         * the dump may come out torn - these are rare and the reader discards
+         * the ones it can't make sense of.
+         */
+        static void dump(const std::string& path);
+
+        /*!
+         * Reads records from a dump file.
+         * @return difference between realtime and monotonic clocks at the
+         *         moment of dump, ns
+         */
+        static int64_t load(const std::string& path,
+                            std::vector<Record>& records);
+
+    private:
+
+        static Record*  buf_;
+        static uint64_t mask_;
+        static uint64_t pos_;
+
+        EventTrace();
+    };
+}
+
+#endif // _gu_event_trace_hpp_
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+/*!
+ * @file Reads event trace dump and shows where replication latency goes.
+ *
+ * Events of each seqno are put in time order and every interval between
+ * consecutive events is attributed to the segment named after them, e.g.
+ * "cert_end -> apply_enter". Segments are then summed up over all seqnos.
+ * gcache release normally lags far behind commit, so it is not considered
+ * part of the critical path and is reported separately.
+ *
+ * Usage: gu_event_trace [-v] <dump file>
+ *        -v  also print per-seqno paths
+ */
+
+#include "gu_event_trace.hpp"
+#include "gu_exception.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+typedef gu::EventTrace ET;
+
+static bool
+time_less(const ET::Record& a, const ET::Record& b)
+{
+    return a.time < b.time;
+}
+
+struct Segment
+{
+    Segment() : count(0), total(0), max(0), longest(0) {}
+
+    void add(int64_t const d)
+    {
+        ++count;
+        total += d;
+        if (d > max) max = d;
+    }
+
+    long long count;
+    int64_t   total;
+    int64_t   max;
+    long long longest; // number of times it was the longest in a path
+};
+
+static void
+print_segment(const std::string& name, const Segment& s, int64_t const all)
+{
+    printf("%-32s %10lld %12.1f %12.1f", name.c_str(), s.count,
+           s.total/1000.0/s.count, s.max/1000.0);
+
+    if (all > 0)
+        printf(" %7.1f%% %10lld\n", s.total*100.0/all, s.longest);
+    else
+        printf("\n");
+}
+
+int main(int argc, char* argv[])
+{
+    bool        verbose(false);
+    const char* path(NULL);
+
+    for (int i(1); i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-v")) verbose = true;
+        else path = argv[i];
+    }
+
+    if (NULL == path)
+    {
+        fprintf(stderr, "Usage: %s [-v] <dump file>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<ET::Record> records;
+    int64_t offset;
+
+    try
+    {
+        offset = ET::load(path, records);
+    }
+    catch (gu::Exception& e)
+    {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    /* replication is requested before seqno is known, match by trx ID */
+    std::map<uint64_t, int64_t> id2seqno;
+
+    for (size_t i(0); i < records.size(); ++i)
+    {
+        const ET::Record& r(records[i]);
+        if (ET::GCS_SEND_END == r.event && r.id != 0 && r.seqno > 0)
+            id2seqno[r.id] = r.seqno;
+    }
+
+    typedef std::map<int64_t, std::vector<ET::Record> > Paths;
+    Paths paths;
+
+    for (size_t i(0); i < records.size(); ++i)
+    {
+        ET::Record r(records[i]);
+
+        if (ET::GCS_SEND_BEGIN == r.event)
+        {
+            std::map<uint64_t, int64_t>::const_iterator j(id2seqno.find(r.id));
+            if (j == id2seqno.end()) continue;
+            r.seqno = j->second;
+        }
+
+        if (r.seqno > 0) paths[r.seqno].push_back(r);
+    }
+
+    std::map<std::string, Segment> segments;
+    Segment path_total;
+    Segment release_lag;
+
+    for (Paths::iterator p(paths.begin()); p != paths.end(); ++p)
+    {
+        std::vector<ET::Record>& evs(p->second);
+        std::stable_sort(evs.begin(), evs.end(), time_less);
+
+        const ET::Record* prev(NULL);
+        int64_t           longest(-1);
+        std::string       longest_name;
+
+        if (verbose)
+        {
+            time_t const t((evs.front().time + offset) / 1000000000LL);
+            char tstr[32];
+            strftime(tstr, sizeof(tstr), "%Y-%m-%d %H:%M:%S", localtime(&t));
+            printf("%lld %s.%06lld:", static_cast<long long>(p->first), tstr,
+                   static_cast<long long>((evs.front().time + offset) %
+                                          1000000000LL / 1000));
+        }
+
+        for (size_t i(0); i < evs.size(); ++i)
+        {
+            const ET::Record& r(evs[i]);
+
+            if (ET::GCACHE_RELEASE == r.event)
+            {
+                if (prev) release_lag.add(r.time - prev->time);
+                continue;
+            }
+
+            if (prev)
+            {
+                int64_t const d(r.time - prev->time);
+                std::string const name(std::string(ET::event_str(prev->event))
+                                       + " -> " + ET::event_str(r.event));
+
+                segments[name].add(d);
+
+                if (d > longest) { longest = d; longest_name = name; }
+            }
+
+            if (verbose)
+            {
+                printf(" %s", ET::event_str(r.event));
+                if (prev) printf(" +%.1f", (r.time - prev->time)/1000.0);
+            }
+
+            prev = &r;
+        }
+
+        if (verbose) printf("\n");
+
+        if (longest >= 0)
+        {
+            segments[longest_name].longest++;
+            path_total.add(prev->time - evs.front().time);
+        }
+    }
+
+    int64_t all(0);
+    std::vector<std::pair<int64_t, std::string> > order;
+
+    for (std::map<std::string, Segment>::const_iterator s(segments.begin());
+         s != segments.end(); ++s)
+    {
+        all += s->second.total;
+        order.push_back(std::make_pair(s->second.total, s->first));
+    }
+
+    std::sort(order.rbegin(), order.rend());
+
+    printf("%zu events, %zu seqnos\n\n", records.size(), paths.size());
+    printf("%-32s %10s %12s %12s %8s %10s\n",
+           "segment", "count", "avg(us)", "max(us)", "share", "longest");
+
+    for (size_t i(0); i < order.size(); ++i)
+    {
+        print_segment(order[i].second, segments[order[i].second], all);
+    }
+
+    if (path_total.count > 0)
+    {
+        printf("\n");
+        print_segment("critical path", path_total, 0);
+    }
+
+    if (release_lag.count > 0)
+    {
+        print_segment("gcache release lag", release_lag, 0);
+    }
+
+    return 0;
+}
@@ -8,6 +8,7 @@
 
 #include "gu_logger.hpp"
 #include "gu_throw.hpp"
+#include "gu_limits.h"
 
 #include <cerrno>
 #include <sys/mman.h>
@@ -64,6 +65,17 @@ namespace gu
         }
     }
 
+    void
+    MMap::prefault() const
+    {
+        /* reading one byte per page is enough to get it mapped, and for
+         * pages not yet cached - allocated by the default (local) policy */
+        size_t const page_size(gu_page_size());
+        const volatile char* const p(static_cast<const volatile char*>(ptr));
+
+        for (size_t off(0); off < size; off += page_size) (void)p[off];
+    }
+
     void
     MMap::sync () const
     {
@@ -25,6 +25,7 @@ public:
     ~MMap ();
 
     void dont_need() const;
+    void prefault() const;
     void sync() const;
     void unmap();
 
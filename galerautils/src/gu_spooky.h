@@ -177,7 +177,8 @@ static GU_FORCE_INLINE void _spooky_short_end(uint64_t* h0, uint64_t* h1,
 // short hash ... it could be used on any message,
 // but it's used by Spooky just for short messages.
 //
-static GU_INLINE void gu_spooky_short_host(
+/* seeded version: seed is taken from hash[0], hash[1] */
+static GU_INLINE void gu_spooky_short_seed_host(
     const void* const message,
     size_t      const length,
     uint64_t*   const hash)
@@ -205,12 +206,9 @@ static GU_INLINE void gu_spooky_short_host(
 
     size_t   remainder = length & 0x1F; /* length%32 */
 
-    /* author version : */
-    // uint64_t a = gu_le64(*hash[0]);
-    // uint64_t b = gu_le64(*hash[1]);
-    /* consistent seed version: */
-    uint64_t a = 0;
-    uint64_t b = 0;
+    /* author version, seed is in host byte order: */
+    uint64_t a = hash[0];
+    uint64_t b = hash[1];
     uint64_t c = _spooky_const;
     uint64_t d = _spooky_const;
 
@@ -290,6 +288,17 @@ static GU_INLINE void gu_spooky_short_host(
     hash[1] = b;
 }
 
+static GU_FORCE_INLINE void gu_spooky_short_host(
+    const void* const message,
+    size_t      const length,
+    uint64_t*   const hash)
+{
+    /* consistent seed version: */
+    hash[0] = 0;
+    hash[1] = 0;
+    gu_spooky_short_seed_host(message, length, hash);
+}
+
 static GU_FORCE_INLINE void gu_spooky_short(
     const void* message,
     size_t      length,
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#include "gu_thread_affinity.hpp"
+#include "gu_config.hpp"
+#include "gu_string_utils.hpp"
+#include "gu_logger.hpp"
+#include "gu_throw.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+const std::string gu::ThreadAffinity::PARAM_PREFIX("thread.");
+
+std::vector<int> gu::ThreadAffinity::cpus_[gu::ThreadAffinity::ROLE_MAX];
+
+static const char* const role_names[gu::ThreadAffinity::ROLE_MAX] =
+{
+    "gcomm",
+    "gcs_recv",
+    "service",
+    "ist",
+    "gcache",
+    "checksum"
+};
+
+static std::string
+role_param(int const role)
+{
+    return gu::ThreadAffinity::PARAM_PREFIX + role_names[role];
+}
+
+void
+gu::ThreadAffinity::register_params(Config& conf)
+{
+    for (int r(0); r < ROLE_MAX; ++r) conf.add(role_param(r));
+}
+
+void
+gu::ThreadAffinity::configure(const Config& conf)
+{
+    for (int r(0); r < ROLE_MAX; ++r)
+    {
+        std::string const key(role_param(r));
+
+        cpus_[r].clear();
+
+        if (!conf.is_set(key)) continue;
+
+        try
+        {
+            parse(conf.get(key), cpus_[r]);
+        }
+        catch (Exception& e)
+        {
+            gu_throw_error(e.get_errno()) << "Bad value for '" << key
+                                          << "': " << e.what();
+        }
+
+        if (cpus_[r].empty()) continue;
+
+#ifdef __linux__
+        log_info << "Binding " << role_names[r] << " threads to CPUs "
+                 << conf.get(key);
+#else
+        log_warn << "Thread affinity is not supported on this platform, "
+                 << "ignoring '" << key << '\'';
+        cpus_[r].clear();
+#endif
+    }
+}
+
+static int
+cpu_number(const std::string& str)
+{
+    char* end;
+    errno = 0;
+    long const n(strtol(str.c_str(), &end, 10));
+
+    if (str.empty() || *end != '\0' || errno || n < 0)
+    {
+        gu_throw_error(EINVAL) << "'" << str << "' is not a CPU number";
+    }
+
+#ifdef CPU_SETSIZE
+    if (n >= CPU_SETSIZE)
+    {
+        gu_throw_error(EINVAL) << "CPU number " << n << " exceeds maximum "
+                               << CPU_SETSIZE - 1;
+    }
+#endif
+
+    return n;
+}
+
+void
+gu::ThreadAffinity::parse(const std::string& str, std::vector<int>& cpus)
+{
+    static std::string const node_prefix("node:");
+
+    std::vector<std::string> const items(strsplit(str, ','));
+
+    for (size_t i(0); i < items.size(); ++i)
+    {
+        size_t const b(items[i].find_first_not_of(" \t\n"));
+        if (std::string::npos == b) continue;
+
+        size_t const e(items[i].find_last_not_of(" \t\n"));
+        std::string const item(items[i].substr(b, e - b + 1));
+
+        if (0 == item.compare(0, node_prefix.length(), node_prefix) &&
+            item.length() > node_prefix.length())
+        {
+            int const node(cpu_number(item.substr(node_prefix.length())));
+            std::ostringstream path;
+            path << "/sys/devices/system/node/node" << node << "/cpulist";
+
+            std::ifstream f(path.str().c_str());
+            std::string   list;
+
+            if (!std::getline(f, list))
+            {
+                gu_throw_error(ENOENT) << "Can't read CPUs of NUMA node "
+                                       << node << " from " << path.str();
+            }
+
+            parse(list, cpus);
+            continue;
+        }
+
+        std::vector<std::string> const range(
+            tokenize(item, '-', '\0', true));
+
+        if (1 == range.size())
+        {
+            cpus.push_back(cpu_number(range[0]));
+        }
+        else if (2 == range.size())
+        {
+            int const first(cpu_number(range[0]));
+            int const last (cpu_number(range[1]));
+
+            if (first > last)
+            {
+                gu_throw_error(EINVAL) << "Bad CPU range '" << item << '\'';
+            }
+
+            for (int c(first); c <= last; ++c) cpus.push_back(c);
+        }
+        else
+        {
+            gu_throw_error(EINVAL) << "Bad CPU range '" << item << '\'';
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+}
+
+/* @return 0 or error code */
+static int
+set_affinity(const std::vector<int>& cpus)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (size_t i(0); i < cpus.size(); ++i) CPU_SET(cpus[i], &set);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    return ENOSYS;
+#endif
+}
+
+void
+gu::ThreadAffinity::apply(Role const role)
+{
+    if (cpus_[role].empty()) return;
+
+    int const err(set_affinity(cpus_[role]));
+
+    if (err)
+    {
+        log_warn << "Failed to bind " << role_names[role] << " thread to "
+                 << "configured CPUs: " << err << " (" << ::strerror(err)
+                 << ')';
+    }
+}
+
+gu::ThreadAffinity::Scoped::Scoped(Role const role) : saved_()
+{
+    if (cpus_[role].empty()) return;
+
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (0 == pthread_getaffinity_np(pthread_self(), sizeof(set), &set))
+    {
+        for (int c(0); c < CPU_SETSIZE; ++c)
+        {
+            if (CPU_ISSET(c, &set)) saved_.push_back(c);
+        }
+    }
+#endif
+
+    if (!saved_.empty()) apply(role);
+}
+
+gu::ThreadAffinity::Scoped::~Scoped()
+{
+    if (!saved_.empty()) (void)set_affinity(saved_);
+}
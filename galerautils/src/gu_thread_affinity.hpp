@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+/*!
+ * @file CPU affinity of internal threads.
+ *
+ * Each thread role can be bound to a set of CPUs given by parameter
+ * thread.<role>, e.g. thread.gcs_recv=node:0 or thread.gcomm=2-3,6.
+ * The value is a comma-separated list of CPU numbers, CPU ranges and
+ * node:<N> entries, the latter standing for all CPUs of NUMA node N.
+ * Threads bind themselves by calling apply() when they start, so the memory
+ * they first touch (like receive queue rows) ends up on the matching node.
+ */
+
+#ifndef _gu_thread_affinity_hpp_
+#define _gu_thread_affinity_hpp_
+
+#include <string>
+#include <vector>
+
+namespace gu
+{
+    class Config;
+
+    class ThreadAffinity
+    {
+    public:
+
+        enum Role
+        {
+            GCOMM,    /*!< group communication protonet thread */
+            GCS_RECV, /*!< gcs receive thread */
+            SERVICE,  /*!< galera service thread */
+            IST,      /*!< IST receiver and sender threads */
+            GCACHE,   /*!< gcache page removal threads */
+            CHECKSUM, /*!< background writeset checksum threads */
+            ROLE_MAX
+        };
+
+        static const std::string PARAM_PREFIX;
+
+        static void register_params(Config& conf);
+
+        /*!
+         * Reads CPU sets of all roles from configuration. Must be called
+         * before any internal threads are started.
+         * @throws gu::Exception if a value can't be parsed
+         */
+        static void configure(const Config& conf);
+
+        /*! @return true if CPU set is configured for role */
+        static bool configured(Role role) { return !cpus_[role].empty(); }
+
+        /*! binds calling thread to CPUs of role, if configured */
+        static void apply(Role role);
+
+        /*!
+         * Binds calling thread to CPUs of role for the lifetime of the object,
+         * e.g. to have memory for that role first touched on the right node.
+         */
+        class Scoped
+        {
+        public:
+            explicit Scoped(Role role);
+            ~Scoped();
+        private:
+            std::vector<int> saved_;
+            Scoped(const Scoped&);
+            Scoped& operator=(const Scoped&);
+        };
+
+        /*! parses CPU list as described above into sorted CPU numbers */
+        static void parse(const std::string& str, std::vector<int>& cpus);
+
+    private:
+
+        static std::vector<int> cpus_[ROLE_MAX];
+
+        ThreadAffinity();
+    };
+}
+
+#endif // _gu_thread_affinity_hpp_
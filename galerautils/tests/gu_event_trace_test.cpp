@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#include "../src/gu_event_trace.hpp"
+#include "../src/gu_exception.hpp"
+
+#include "gu_event_trace_test.hpp"
+
+#include <cstdio>
+
+using namespace gu;
+
+START_TEST(test_event_trace)
+{
+    const char* const path("gu_event_trace_test.dump");
+    std::vector<EventTrace::Record> recs;
+
+    /* nothing recorded while disabled */
+    fail_if(EventTrace::enabled());
+    EventTrace::record(EventTrace::CERT_BEGIN, 1);
+    try
+    {
+        EventTrace::dump(path);
+        fail("dump of disabled trace must fail");
+    }
+    catch (gu::Exception& e) {}
+
+    EventTrace::init(5); // rounded up to 8
+    fail_if(!EventTrace::enabled());
+
+    /* partially filled ring */
+    EventTrace::record(EventTrace::GCS_SEND_BEGIN, -1, 42);
+    EventTrace::record(EventTrace::GCS_SEND_END, 1, 42);
+    EventTrace::dump(path);
+    (void)EventTrace::load(path, recs);
+
+    fail_if(recs.size() != 2, "expected 2 records, got %zu", recs.size());
+    fail_if(recs[0].event != EventTrace::GCS_SEND_BEGIN);
+    fail_if(recs[0].seqno != -1);
+    fail_if(recs[0].id    != 42);
+    fail_if(recs[1].event != EventTrace::GCS_SEND_END);
+    fail_if(recs[1].seqno != 1);
+    fail_if(recs[1].time  <  recs[0].time);
+
+    /* wrapped ring keeps the most recent records, oldest first */
+    for (int64_t s(2); s <= 10; ++s)
+    {
+        EventTrace::record(EventTrace::GCACHE_RELEASE, s);
+    }
+
+    EventTrace::dump(path);
+    (void)EventTrace::load(path, recs);
+
+    fail_if(recs.size() != 8, "expected 8 records, got %zu", recs.size());
+    for (size_t i(0); i < recs.size(); ++i)
+    {
+        fail_if(recs[i].event != EventTrace::GCACHE_RELEASE);
+        fail_if(recs[i].seqno != int64_t(i + 3), "expected seqno %zu, got %lld",
+                i + 3, static_cast<long long>(recs[i].seqno));
+        fail_if(recs[i].id != 0);
+    }
+
+    /* ring size is fixed once allocated */
+    EventTrace::init(1024);
+    for (int64_t s(11); s <= 20; ++s)
+    {
+        EventTrace::record(EventTrace::APPLY_ENTER, s);
+    }
+    EventTrace::dump(path);
+    (void)EventTrace::load(path, recs);
+    fail_if(recs.size() != 8, "expected 8 records, got %zu", recs.size());
+
+    ::remove(path);
+
+    try
+    {
+        (void)EventTrace::load(path, recs);
+        fail("load of missing file must fail");
+    }
+    catch (gu::Exception& e) {}
+}
+END_TEST
+
+Suite* gu_event_trace_suite()
+{
+    TCase* t = tcase_create ("test_event_trace");
+    tcase_add_test (t, test_event_trace);
+
+    Suite* s = suite_create ("gu::EventTrace");
+    suite_add_tcase (s, t);
+
+    return s;
+}
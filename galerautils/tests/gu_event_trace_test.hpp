@@ -0,0 +1,12 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#ifndef __gu_event_trace_test__
+#define __gu_event_trace_test__
+
+#include <check.h>
+
+extern Suite *gu_event_trace_suite(void);
+
+#endif // __gu_event_trace_test__
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#include "../src/gu_thread_affinity.hpp"
+#include "../src/gu_config.hpp"
+#include "../src/gu_exception.hpp"
+
+#include "gu_thread_affinity_test.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace gu;
+
+static bool
+parse_fails(const std::string& str)
+{
+    std::vector<int> cpus;
+
+    try
+    {
+        ThreadAffinity::parse(str, cpus);
+        return false;
+    }
+    catch (gu::Exception& e)
+    {
+        return true;
+    }
+}
+
+START_TEST(test_parse)
+{
+    std::vector<int> cpus;
+
+    ThreadAffinity::parse("", cpus);
+    fail_if(!cpus.empty());
+
+    ThreadAffinity::parse("6, 2-4,3,0", cpus);
+    fail_if(cpus.size() != 5, "expected 5 CPUs, got %zu", cpus.size());
+    fail_if(cpus[0] != 0);
+    fail_if(cpus[1] != 2);
+    fail_if(cpus[2] != 3);
+    fail_if(cpus[3] != 4);
+    fail_if(cpus[4] != 6);
+
+    fail_if(!parse_fails("1-"));
+    fail_if(!parse_fails("3-1"));
+    fail_if(!parse_fails("1-2-3"));
+    fail_if(!parse_fails("x"));
+    fail_if(!parse_fails("node:x"));
+    fail_if(!parse_fails("node:100000"));
+}
+END_TEST
+
+START_TEST(test_configure)
+{
+    Config conf;
+    ThreadAffinity::register_params(conf);
+
+    ThreadAffinity::configure(conf);
+    for (int r(0); r < ThreadAffinity::ROLE_MAX; ++r)
+    {
+        fail_if(ThreadAffinity::configured(ThreadAffinity::Role(r)));
+    }
+
+    conf.parse("thread.gcs_recv = 0; thread.service = 0-0");
+    ThreadAffinity::configure(conf);
+#ifdef __linux__
+    fail_if(!ThreadAffinity::configured(ThreadAffinity::GCS_RECV));
+    fail_if(!ThreadAffinity::configured(ThreadAffinity::SERVICE));
+    fail_if(ThreadAffinity::configured(ThreadAffinity::GCOMM));
+
+    cpu_set_t before, pinned, after;
+    fail_if(pthread_getaffinity_np(pthread_self(), sizeof(before), &before));
+    {
+        ThreadAffinity::Scoped pin(ThreadAffinity::GCS_RECV);
+        fail_if(pthread_getaffinity_np(pthread_self(), sizeof(pinned),
+                                       &pinned));
+        fail_if(CPU_COUNT(&pinned) != 1 || !CPU_ISSET(0, &pinned));
+    }
+    fail_if(pthread_getaffinity_np(pthread_self(), sizeof(after), &after));
+    fail_if(!CPU_EQUAL(&before, &after), "original CPU mask not restored");
+#endif /* __linux__ */
+
+    conf.set("thread.ist", "0-");
+    try
+    {
+        ThreadAffinity::configure(conf);
+        fail("bad CPU list must be rejected");
+    }
+    catch (gu::Exception& e) {}
+
+    conf.set("thread.ist", "");
+    conf.set("thread.gcs_recv", "");
+    conf.set("thread.service", "");
+    ThreadAffinity::configure(conf);
+    fail_if(ThreadAffinity::configured(ThreadAffinity::GCS_RECV));
+}
+END_TEST
+
+Suite* gu_thread_affinity_suite()
+{
+    TCase* t = tcase_create ("test_thread_affinity");
+    tcase_add_test (t, test_parse);
+    tcase_add_test (t, test_configure);
+
+    Suite* s = suite_create ("gu::ThreadAffinity");
+    suite_add_tcase (s, t);
+
+    return s;
+}
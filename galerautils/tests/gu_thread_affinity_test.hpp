@@ -0,0 +1,12 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#ifndef __gu_thread_affinity_test__
+#define __gu_thread_affinity_test__
+
+#include <check.h>
+
+extern Suite *gu_thread_affinity_suite(void);
+
+#endif // __gu_thread_affinity_test__
@@ -39,6 +39,7 @@ Config::Config (int argc, char* argv[])
       sst_     (DEFAULT_SST),
       donor_   (),
       options_ (),
+      ist_dir_ (),
       log_     (),
       cfg_     (),
       exit_    (false)
@@ -59,6 +60,8 @@ Config::Config (int argc, char* argv[])
         ("sst",      po::value<std::string>(&sst_),     "SST request string")
         ("donor",    po::value<std::string>(&donor_),   "SST donor name")
         ("options,o",po::value<std::string>(&options_), "GCS/GCOMM option list")
+        ("ist-donor",po::value<std::string>(&ist_dir_),
+         "Cache replication stream in this directory to donate IST")
         ("log,l",    po::value<std::string>(&log_),     "Log file")
         ;
 
@@ -135,6 +138,7 @@ Config::Config (int argc, char* argv[])
     strip_quotes(sst_);
     strip_quotes(donor_);
     strip_quotes(options_);
+    strip_quotes(ist_dir_);
     strip_quotes(log_);
     strip_quotes(cfg_);
 
@@ -166,6 +170,7 @@ std::ostream& operator << (std::ostream& os, const Config& c)
        << "\n\tsst:     " << c.sst()
        << "\n\tdonor:   " << c.donor()
        << "\n\toptions: " << c.options()
+       << "\n\tist dir: " << c.ist_dir()
        << "\n\tcfg:     " << c.cfg()
        << "\n\tlog:     " << c.log();
     return os;
@@ -25,6 +25,7 @@ public:
     const std::string& sst()     const { return sst_    ; }
     const std::string& donor()   const { return donor_  ; }
     const std::string& options() const { return options_; }
+    const std::string& ist_dir() const { return ist_dir_; }
     const std::string& cfg()     const { return cfg_    ; }
     const std::string& log()     const { return log_    ; }
     bool               exit()    const { return exit_   ; }
@@ -38,6 +39,7 @@ private:
     std::string sst_;
     std::string donor_;
     std::string options_;
+    std::string ist_dir_;
     std::string log_;
     std::string cfg_;
     bool exit_; /* Exit on --help or --version */
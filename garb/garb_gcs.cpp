@@ -13,11 +13,12 @@ static int const APPL_PROTO_VER(127);
 Gcs::Gcs (gu::Config&        gconf,
           const std::string& name,
           const std::string& address,
-          const std::string& group)
+          const std::string& group,
+          gcache_t*          cache)
 :
     closed_ (true),
     gcs_ (gcs_create (reinterpret_cast<gu_config_t*>(&gconf),
-                      NULL,
+                      cache,
                       name.c_str(),
                       "",
                       REPL_PROTO_VER, APPL_PROTO_VER))
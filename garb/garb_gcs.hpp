@@ -16,7 +16,8 @@ public:
     Gcs (gu::Config&        conf,
          const std::string& name,
          const std::string& address,
-         const std::string& group);
+         const std::string& group,
+         gcache_t*          cache = NULL);
 
     ~Gcs ();
 
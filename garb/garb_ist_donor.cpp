@@ -0,0 +1,257 @@
+/* Copyright (C) 2015 Codership Oy <info@codership.com> */
+
+#include "garb_ist_donor.hpp"
+
+#include <gcs_action_source.hpp> // GcsActionTrx
+#include <uuid.hpp>
+
+#include <gu_byteswap.h>
+#include <gu_serialize.hpp>
+#include <gu_logger.hpp>
+
+#include <sstream>
+#include <cstring>
+
+namespace garb
+{
+
+/* see StateRequest_v1 in galera/src/replicator_str.cpp */
+static std::string const STR_V1_MAGIC("STRv1");
+
+void
+IstDonor::register_params (gu::Config& conf)
+{
+    gcache::GCache::register_params(conf);
+    galera::Certification::register_params(conf);
+    galera::ist::register_params(conf);
+}
+
+IstDonor::IstDonor (gu::Config& conf, const std::string& dir)
+    :
+    conf_         (conf),
+    gcache_       (conf, dir),
+    gcs_          (conf, gcache_),
+    service_thd_  (gcs_, gcache_),
+    slave_pool_   (sizeof(galera::TrxHandle), 1024, "SlaveTrxHandle"),
+    cert_         (conf, service_thd_),
+    ist_senders_  (gcache_),
+    state_uuid_   (WSREP_UUID_UNDEFINED),
+    cc_seqno_     (GCS_SEQNO_ILL),
+    cache_first_  (GCS_SEQNO_ILL),
+    cache_last_   (GCS_SEQNO_ILL),
+    proto_ver_    (-1),
+    trx_proto_ver_(-1)
+{
+    log_info << "Caching replication stream for IST in '" << dir << "'";
+}
+
+IstDonor::~IstDonor ()
+{
+    ist_senders_.cancel();
+}
+
+void
+IstDonor::conf_change (const gcs_act_conf_t& conf)
+{
+    using galera::operator!=;
+    using galera::operator==;
+
+    assert (conf.conf_id >= 0);
+
+    wsrep_uuid_t uuid;
+    ::memcpy (&uuid, conf.uuid, sizeof(uuid));
+
+    if (uuid != state_uuid_ || conf.seqno != cache_last_)
+    {
+        /* history changed or we missed a part of it (e.g. while being
+         * partitioned), whatever is cached can't be donated */
+        if (uuid == state_uuid_)
+        {
+            log_info << "Cached history " << cache_first_ << '-'
+                     << cache_last_ << " does not reach group seqno "
+                     << conf.seqno << ", discarding it";
+        }
+
+        ist_senders_.cancel();
+        gcache_.seqno_reset();
+        state_uuid_  = uuid;
+        cache_first_ = conf.seqno + 1;
+        cache_last_  = conf.seqno;
+    }
+
+    proto_ver_     = conf.repl_proto_ver;
+    trx_proto_ver_ = galera::TrxHandle::version_for_repl_proto(proto_ver_);
+
+    cert_.assign_initial_position(
+        conf.seqno, trx_proto_ver_,
+        galera::KeySet::fast_hash_for_repl_proto(proto_ver_));
+    service_thd_.flush();
+
+    cc_seqno_ = conf.seqno;
+}
+
+void
+IstDonor::ordered (const gcs_action& act)
+{
+    assert (act.seqno_g > cc_seqno_);
+    assert (act.seqno_g == cache_last_ + 1);
+
+    cache_last_ = act.seqno_g;
+
+    if (gu_unlikely(trx_proto_ver_ < galera::WS_NG_VERSION))
+    {
+        /* IST won't be donated anyway, don't let the cache grow */
+        gcache_.seqno_assign (act.buf, act.seqno_g, -1);
+        gcache_.seqno_release (act.seqno_g);
+        return;
+    }
+
+    galera::GcsActionTrx trx(slave_pool_, act);
+    galera::TrxHandle* const th(trx.trx());
+
+    th->set_state(galera::TrxHandle::S_REPLICATING);
+    th->set_state(galera::TrxHandle::S_CERTIFYING);
+
+    /* failed certification sets depends_seqno to -1, that's all we need */
+    (void)cert_.append_trx(th);
+
+    th->verify_checksum();
+
+    gcache_.seqno_assign (act.buf, act.seqno_g, th->depends_seqno());
+
+    /* nothing to apply, index purge is driven by commit cut */
+    (void)cert_.set_trx_committed(th);
+}
+
+void
+IstDonor::commit_cut (const gcs_action& act)
+{
+    gcs_seqno_t seq;
+    gu::unserialize8(static_cast<const gu::byte_t*>(act.buf), act.size, 0,
+                     seq);
+
+    /* see ReplicatorSMM::process_commit_cut() */
+    if (seq >= cc_seqno_) cert_.purge_trxs_upto(seq, true);
+}
+
+gcs_seqno_t
+IstDonor::state_request (const gcs_action& act)
+{
+    using galera::operator>>;
+    using galera::operator!=;
+
+    const char* const req(static_cast<const char*>(act.buf));
+    size_t const      len(act.size);
+    size_t const      sst_off(STR_V1_MAGIC.length() + 1);
+
+    if (len < sst_off + 2*sizeof(uint32_t) ||
+        ::strncmp(req, STR_V1_MAGIC.c_str(), STR_V1_MAGIC.length()))
+    {
+        log_info << "State request carries no IST request, can't donate SST";
+        return -ENOSYS;
+    }
+
+    uint32_t const sst_len(gtohl(*reinterpret_cast<const uint32_t*>
+                                 (req + sst_off)));
+
+    if (sst_len > 0)
+    {
+        /* joiner would wait for SST bypass notification which only SST
+         * script on a data node can send */
+        log_info << "State request includes SST request, can't donate SST";
+        return -ENOSYS;
+    }
+
+    size_t const   ist_off(sst_off + sizeof(uint32_t));
+    uint32_t const ist_len(gtohl(*reinterpret_cast<const uint32_t*>
+                                 (req + ist_off)));
+
+    if (0 == ist_len || ist_off + sizeof(uint32_t) + ist_len != len)
+    {
+        log_warn << "Malformed IST request, total length: " << len
+                 << ", IST request length: " << ist_len;
+        return -EINVAL;
+    }
+
+    std::istringstream is(std::string(req + ist_off + sizeof(uint32_t),
+                                      ist_len));
+    wsrep_uuid_t  uuid;
+    gcs_seqno_t   last_applied;
+    gcs_seqno_t   group_seqno;
+    std::string   peer;
+    char          c;
+
+    try
+    {
+        is >> uuid >> c >> last_applied >> c >> group_seqno >> c >> peer;
+    }
+    catch (gu::Exception& e) // malformed UUID
+    {
+        is.setstate(std::ios::failbit);
+    }
+
+    if (is.fail())
+    {
+        log_warn << "Failed to parse IST request";
+        return -EINVAL;
+    }
+
+    log_info << "IST request: " << peer << ", seqnos " << last_applied + 1
+             << '-' << cc_seqno_;
+
+    if (uuid != state_uuid_ || trx_proto_ver_ < galera::WS_NG_VERSION)
+    {
+        log_info << "Can't donate IST for this state or protocol version";
+        return -ENOSYS;
+    }
+
+    if (last_applied + 1 < cache_first_)
+    {
+        log_info << "IST first seqno " << last_applied + 1
+                 << " precedes cached history " << cache_first_ << '-'
+                 << cache_last_;
+        return -ENODATA;
+    }
+
+    try
+    {
+        gcache_.seqno_lock(last_applied + 1);
+    }
+    catch (gu::NotFound& nf)
+    {
+        log_info << "IST first seqno " << last_applied + 1
+                 << " not found from cache";
+        return -ENODATA;
+    }
+
+    try
+    {
+        /* see ReplicatorSMM::process_state_req() on why cc_seqno_ */
+        ist_senders_.run(conf_, peer, last_applied + 1, cc_seqno_, proto_ver_);
+    }
+    catch (gu::Exception& e)
+    {
+        log_error << "IST failed: " << e.what();
+        gcache_.seqno_unlock();
+        return -e.get_errno();
+    }
+
+    return act.seqno_g;
+}
+
+void
+IstDonor::release (const gcs_action& act)
+{
+    switch (act.type)
+    {
+    case GCS_ACT_TORDERED:
+        break; // owned by gcache since seqno_assign()
+    case GCS_ACT_STATE_REQ:
+        gcache_.free (const_cast<void*>(act.buf));
+        break;
+    default:
+        ::free (const_cast<void*>(act.buf));
+    }
+}
+
+} /* namespace garb */
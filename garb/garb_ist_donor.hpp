@@ -0,0 +1,78 @@
+/* Copyright (C) 2015 Codership Oy <info@codership.com> */
+
+#ifndef _GARB_IST_DONOR_HPP_
+#define _GARB_IST_DONOR_HPP_
+
+#include <galera_gcs.hpp>
+#include <galera_service_thd.hpp>
+#include <certification.hpp>
+#include <trx_handle.hpp>
+#include <ist.hpp>
+
+#include <GCache.hpp>
+#include <gcs.hpp>
+#include <gu_config.hpp>
+
+namespace garb
+{
+
+/*!
+ * Keeps replication stream in gcache ring buffer and donates IST from it.
+ *
+ * Arbitrator does not apply writesets, but IST receiver relies on donor
+ * certification results (rolled back writesets are sent with seqno_d == -1),
+ * so the stream is certified here the same way data nodes do it. Certification
+ * starts at the configuration change where arbitrator joins, so only seqnos
+ * received after that can be donated. Cache is discarded at configuration
+ * change if it does not continue up to the group seqno, IST can't skip seqnos.
+ */
+class IstDonor
+{
+public:
+
+    static void register_params (gu::Config&);
+
+    IstDonor (gu::Config& conf, const std::string& dir);
+
+    ~IstDonor ();
+
+    gcache_t* gcache() { return reinterpret_cast<gcache_t*>(&gcache_); }
+
+    /*! primary configuration change */
+    void conf_change (const gcs_act_conf_t& conf);
+
+    /*! certifies writeset and assigns it seqnos in gcache */
+    void ordered (const gcs_action& act);
+
+    void commit_cut (const gcs_action& act);
+
+    /*! @return seqno to join the group with, or negative error code */
+    gcs_seqno_t state_request (const gcs_action& act);
+
+    /*! releases action buffer allocated by gcs */
+    void release (const gcs_action& act);
+
+private:
+
+    gu::Config&                  conf_;
+    gcache::GCache               gcache_;
+    galera::DummyGcs             gcs_; // reports nothing, see ServiceThd
+    galera::ServiceThd           service_thd_;
+    galera::TrxHandle::SlavePool slave_pool_;
+    galera::Certification        cert_;
+    galera::ist::AsyncSenderMap  ist_senders_;
+    wsrep_uuid_t                 state_uuid_;
+    gcs_seqno_t                  cc_seqno_;
+    gcs_seqno_t                  cache_first_; // cached history is
+    gcs_seqno_t                  cache_last_;  // contiguous between these
+    int                          proto_ver_;
+    int                          trx_proto_ver_;
+
+    IstDonor (const IstDonor&);
+    IstDonor& operator= (const IstDonor&);
+
+}; /* class IstDonor */
+
+} /* namespace garb */
+
+#endif /* _GARB_IST_DONOR_HPP_ */
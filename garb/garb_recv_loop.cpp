@@ -24,7 +24,10 @@ RecvLoop::RecvLoop (const Config& config)
     gconf_ (),
     params_(gconf_),
     parse_ (gconf_, config_.options()),
-    gcs_   (gconf_, config_.name(), config_.address(), config_.group())
+    donor_ (config_.ist_dir().empty() ? NULL :
+            new IstDonor(gconf_, config_.ist_dir())),
+    gcs_   (gconf_, config_.name(), config_.address(), config_.group(),
+            donor_ ? donor_->gcache() : NULL)
 {
     /* set up signal handlers */
     global_gcs = &gcs_;
@@ -61,6 +64,8 @@ RecvLoop::loop()
         switch (act.type)
         {
         case GCS_ACT_TORDERED:
+            if (donor_) donor_->ordered(act);
+
             if (gu_unlikely(!(act.seqno_g & 127)))
                 /* == report_interval_ of 128 */
             {
@@ -68,9 +73,11 @@ RecvLoop::loop()
             }
             break;
         case GCS_ACT_COMMIT_CUT:
+            if (donor_) donor_->commit_cut(act);
             break;
         case GCS_ACT_STATE_REQ:
-            gcs_.join (-ENOSYS); /* we can't donate state */
+            /* we can't donate state, only IST from cache */
+            gcs_.join (donor_ ? donor_->state_request(act) : -ENOSYS);
             break;
         case GCS_ACT_CONF:
         {
@@ -79,6 +86,8 @@ RecvLoop::loop()
 
             if (cc->conf_id > 0) /* PC */
             {
+                if (donor_) donor_->conf_change(*cc);
+
                 if (GCS_NODE_STATE_PRIM == cc->my_state)
                 {
                     gcs_.request_state_transfer (config_.sst(),config_.donor());
@@ -110,7 +119,10 @@ RecvLoop::loop()
 
         if (act.buf)
         {
-            free (const_cast<void*>(act.buf));
+            if (donor_)
+                donor_->release(act);
+            else
+                free (const_cast<void*>(act.buf));
         }
     }
 }
@@ -5,6 +5,7 @@
 
 #include "garb_gcs.hpp"
 #include "garb_config.hpp"
+#include "garb_ist_donor.hpp"
 
 #include <gu_throw.hpp>
 #include <gu_asio.hpp>
@@ -20,7 +21,7 @@ public:
 
     RecvLoop (const Config&);
 
-    ~RecvLoop () {}
+    ~RecvLoop () { delete donor_; }
 
 private:
 
@@ -34,6 +35,7 @@ private:
         RegisterParams(gu::Config& cnf)
         {
             gu::ssl_register_params(cnf);
+            IstDonor::register_params(cnf);
             if (gcs_register_params(reinterpret_cast<gu_config_t*>(&cnf)))
             {
                 gu_throw_fatal << "Error initializing GCS parameters";
@@ -51,7 +53,11 @@ private:
     }
         parse_;
 
+    IstDonor*     donor_; // NULL unless IST donation is configured
     Gcs           gcs_;
+
+    RecvLoop (const RecvLoop&);
+    RecvLoop& operator= (const RecvLoop&);
 }; /* RecvLoop */
 
 } /* namespace garb */
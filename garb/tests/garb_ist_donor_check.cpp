@@ -0,0 +1,283 @@
+/* Copyright (C) 2015 Codership Oy <info@codership.com> */
+
+#include "../garb_ist_donor.hpp"
+
+#include <gcache.h>   // gcache_malloc()
+#include <gu_asio.hpp> // gu::ssl_register_params()
+#include <gu_byteswap.h>
+#include <uuid.hpp>
+
+#include <check.h>
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+using galera::TrxHandle;
+
+static std::string const GCACHE_NAME("garb_ist_donor_check.cache");
+
+static gu::Config*
+donor_config()
+{
+    gu::Config* const conf(new gu::Config);
+
+    gu::ssl_register_params(*conf);
+    garb::IstDonor::register_params(*conf);
+
+    conf->set("gcache.name", GCACHE_NAME);
+    conf->set("gcache.size", "1M");
+
+    return conf;
+}
+
+static void
+conf_change (garb::IstDonor&     donor,
+             const wsrep_uuid_t& uuid,
+             gcs_seqno_t const   seqno)
+{
+    gcs_act_conf_t conf;
+    ::memset(&conf, 0, sizeof(conf));
+
+    conf.seqno          = seqno;
+    conf.conf_id        = 1;
+    ::memcpy(conf.uuid, &uuid, sizeof(conf.uuid));
+    conf.memb_num       = 1;
+    conf.my_idx         = 0;
+    conf.my_state       = GCS_NODE_STATE_PRIM;
+    conf.repl_proto_ver = 7;
+    conf.appl_proto_ver = 1;
+
+    donor.conf_change(conf);
+}
+
+/* puts a writeset in donor cache as if it was received from the group */
+static void
+ordered (garb::IstDonor&       donor,
+         TrxHandle::LocalPool& lp,
+         const wsrep_uuid_t&   uuid,
+         gcs_seqno_t const     seqno)
+{
+    int const trx_version(TrxHandle::version_for_repl_proto(7));
+    TrxHandle::Params const trx_params("", trx_version,
+                                       galera::KeySet::MAX_VERSION);
+    TrxHandle* const trx(TrxHandle::New(lp, trx_params, uuid, 1, seqno));
+
+    const wsrep_buf_t key[2] = {
+        {"key1", 4},
+        {"key2", 4}
+    };
+
+    trx->append_key(galera::KeyData(trx_version, key, 2, WSREP_KEY_EXCLUSIVE,
+                                    true));
+    trx->append_data("bar", 3, WSREP_DATA_ORDERED, true);
+
+    galera::WriteSetNG::GatherVector bufs;
+    ssize_t const size(trx->write_set_out().gather(trx->source_id(),
+                                                   trx->conn_id(),
+                                                   trx->trx_id(),
+                                                   bufs));
+    trx->set_last_seen_seqno(seqno - 1);
+
+    gu::byte_t* const ptr(static_cast<gu::byte_t*>
+                          (gcache_malloc(donor.gcache(), size)));
+    gu::byte_t* p(ptr);
+    for (size_t i(0); i < bufs->size(); ++i)
+    {
+        ::memcpy(p, bufs[i].ptr, bufs[i].size); p += bufs[i].size;
+    }
+    fail_if((p - ptr) != size);
+
+    trx->unref();
+
+    gcs_action act;
+    act.buf     = ptr;
+    act.size    = size;
+    act.seqno_g = seqno;
+    act.seqno_l = seqno;
+    act.type    = GCS_ACT_TORDERED;
+
+    donor.ordered(act);
+}
+
+/* see StateRequest_v1 in galera/src/replicator_str.cpp */
+static std::vector<char>
+state_request (const std::string& sst, const std::string& ist)
+{
+    static std::string const magic("STRv1");
+
+    std::vector<char> req(magic.length() + 1 + sizeof(uint32_t) + sst.length()
+                          + sizeof(uint32_t) + ist.length());
+    char* ptr(&req[0]);
+
+    ::strcpy(ptr, magic.c_str());
+    ptr += magic.length() + 1;
+
+    *reinterpret_cast<uint32_t*>(ptr) = htogl(sst.length());
+    ptr += sizeof(uint32_t);
+    ::memcpy(ptr, sst.data(), sst.length());
+    ptr += sst.length();
+
+    *reinterpret_cast<uint32_t*>(ptr) = htogl(ist.length());
+    ptr += sizeof(uint32_t);
+    ::memcpy(ptr, ist.data(), ist.length());
+
+    return req;
+}
+
+/* IST receiver address: accepts connections, but never answers, so IST
+ * sender stays in handshake until it is canceled */
+static std::string
+ist_peer()
+{
+    static std::string peer;
+
+    if (peer.empty())
+    {
+        int const fd(::socket(AF_INET, SOCK_STREAM, 0));
+        fail_if(fd < 0);
+
+        struct sockaddr_in addr;
+        ::memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len(sizeof(addr));
+
+        fail_if(::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), len));
+        fail_if(::listen(fd, 16));
+        fail_if(::getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr),
+                              &len));
+
+        std::ostringstream os;
+        os << "tcp://127.0.0.1:" << ntohs(addr.sin_port);
+        peer = os.str();
+    }
+
+    return peer;
+}
+
+/* see IST_request in galera/src/replicator_str.cpp */
+static std::string
+ist_request (const wsrep_uuid_t& uuid,
+             gcs_seqno_t const   last_applied,
+             gcs_seqno_t const   group_seqno)
+{
+    using galera::operator<<;
+
+    std::ostringstream os;
+    os << uuid << ':' << last_applied << '-' << group_seqno << '|'
+       << ist_peer();
+    return os.str();
+}
+
+static gcs_seqno_t
+request (garb::IstDonor& donor, const std::vector<char>& req)
+{
+    gcs_action act;
+    act.buf     = &req[0];
+    act.size    = req.size();
+    act.seqno_g = 1000;
+    act.seqno_l = 1000;
+    act.type    = GCS_ACT_STATE_REQ;
+
+    return donor.state_request(act);
+}
+
+START_TEST(test_state_request)
+{
+    gu::Config* const conf(donor_config());
+    garb::IstDonor* const donor(new garb::IstDonor(*conf, "."));
+
+    wsrep_uuid_t uuid;
+    gu_uuid_generate(reinterpret_cast<gu_uuid_t*>(&uuid), 0, 0);
+
+    conf_change(*donor, uuid, 0);
+
+    std::vector<char> req(state_request("", ist_request(uuid, 0, 0)));
+    std::vector<char> bad(req);
+
+    bad[0] = 'X';
+    fail_if(request(*donor, bad) != -ENOSYS, "wrong magic accepted");
+
+    bad.assign(req.begin(), req.begin() + 8);
+    fail_if(request(*donor, bad) != -ENOSYS, "short request accepted");
+
+    bad = state_request("rsync", ist_request(uuid, 0, 0));
+    fail_if(request(*donor, bad) != -ENOSYS, "SST request accepted");
+
+    bad = state_request("", "");
+    fail_if(request(*donor, bad) != -EINVAL, "empty IST request accepted");
+
+    bad = req;
+    bad.push_back('\0');
+    fail_if(request(*donor, bad) != -EINVAL, "wrong IST length accepted");
+
+    bad = state_request("", "garbage");
+    fail_if(request(*donor, bad) != -EINVAL, "garbage IST request accepted");
+
+    wsrep_uuid_t other;
+    gu_uuid_generate(reinterpret_cast<gu_uuid_t*>(&other), 0, 0);
+    bad = state_request("", ist_request(other, 0, 0));
+    fail_if(request(*donor, bad) != -ENOSYS, "foreign history accepted");
+
+    delete donor;
+    delete conf;
+    ::unlink(GCACHE_NAME.c_str());
+}
+END_TEST
+
+START_TEST(test_history_gap)
+{
+    gu::Config* const conf(donor_config());
+    garb::IstDonor* const donor(new garb::IstDonor(*conf, "."));
+    TrxHandle::LocalPool lp(TrxHandle::LOCAL_STORAGE_SIZE, 4, "garb_check");
+
+    wsrep_uuid_t uuid;
+    gu_uuid_generate(reinterpret_cast<gu_uuid_t*>(&uuid), 0, 0);
+
+    conf_change(*donor, uuid, 0);
+    for (gcs_seqno_t s(1); s <= 5; ++s) ordered(*donor, lp, uuid, s);
+
+    /* contiguous configuration change keeps the cache */
+    conf_change(*donor, uuid, 5);
+    fail_if(request(*donor, state_request("", ist_request(uuid, 2, 5)))
+            != 1000, "IST of cached history refused");
+
+    /* rejoin after the group went on without us: 6-8 were missed */
+    conf_change(*donor, uuid, 8);
+    fail_if(request(*donor, state_request("", ist_request(uuid, 2, 8)))
+            != -ENODATA, "IST across history gap accepted");
+
+    for (gcs_seqno_t s(9); s <= 10; ++s) ordered(*donor, lp, uuid, s);
+    conf_change(*donor, uuid, 10);
+    fail_if(request(*donor, state_request("", ist_request(uuid, 7, 10)))
+            != -ENODATA, "IST of missed seqno accepted");
+    fail_if(request(*donor, state_request("", ist_request(uuid, 8, 10)))
+            != 1000, "IST of history cached after the gap refused");
+
+    delete donor;
+    delete conf;
+    ::unlink(GCACHE_NAME.c_str());
+}
+END_TEST
+
+Suite* garb_ist_donor_suite()
+{
+    Suite* s(suite_create("garb_ist_donor"));
+    TCase* tc;
+
+    tc = tcase_create("test_state_request");
+    tcase_add_test(tc, test_state_request);
+    suite_add_tcase(s, tc);
+
+    tc = tcase_create("test_history_gap");
+    tcase_set_timeout(tc, 60);
+    tcase_add_test(tc, test_history_gap);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
@@ -6,6 +6,8 @@
 #include "gcache_bh.hpp"
 
 #include <gu_logger.hpp>
+#include <gu_thread_affinity.hpp>
+#include <gu_time.h>
 
 #include <cerrno>
 #include <unistd.h>
@@ -25,6 +27,8 @@ namespace gcache
         seqno_locked   = SEQNO_NONE;
         seqno_max      = SEQNO_NONE;
         seqno_released = SEQNO_NONE;
+        release_target = SEQNO_NONE;
+        release_ns     = 0;
 
         seqno2ptr.clear();
 
@@ -34,13 +38,34 @@ namespace gcache
     }
 
     void
-    GCache::constructor_common() {}
+    GCache::constructor_common()
+    {
+        /* Most of the buffers are written by gcs receive thread, so have
+         * ring buffer pages allocated on its NUMA node. This reads every
+         * page of the ring buffer, so startup time grows with its size. */
+        if (gu::ThreadAffinity::configured(gu::ThreadAffinity::GCS_RECV))
+        {
+            log_info << "Prefaulting " << params.rb_size()
+                     << " bytes of ring buffer on gcs receive thread CPUs...";
+
+            long long const start(gu_time_monotonic());
+            {
+                gu::ThreadAffinity::Scoped pin(gu::ThreadAffinity::GCS_RECV);
+                rb.prefault();
+            }
+
+            log_info << "Prefaulting ring buffer done in "
+                     << double(gu_time_monotonic() - start)/1.0e9 << " sec";
+        }
+    }
 
     GCache::GCache (gu::Config& cfg, const std::string& data_dir)
         :
         config    (cfg),
         params    (config, data_dir),
         mtx       (),
+        seqno_mtx (),
+        lock_mtx  (),
         cond      (),
         seqno2ptr (),
         mem       (params.mem_size(), seqno2ptr),
@@ -55,7 +80,9 @@ namespace gcache
         frees     (0),
         seqno_locked(SEQNO_NONE),
         seqno_max   (SEQNO_NONE),
-        seqno_released(0)
+        seqno_released(0),
+        release_target(0),
+        release_ns    (0)
 #ifndef NDEBUG
         ,buf_tracker()
 #endif
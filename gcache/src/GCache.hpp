@@ -15,7 +15,6 @@
 
 #include <string>
 #include <iostream>
-#include <map>
 #ifndef NDEBUG
 #include <set>
 #endif
@@ -69,17 +68,28 @@ namespace gcache
 
         /*!
          * Release (free) buffers up to seqno
+         *
+         * @param slice_ns if positive, return after spending roughly that
+         *                 much time, the rest can be released by subsequent
+         *                 calls
+         * @return true if all buffers up to seqno were released
          */
-        void seqno_release (int64_t seqno);
+        bool seqno_release (int64_t seqno, long long slice_ns = 0);
+
+        /*!
+         * Returns the number of seqnos requested for release but not released
+         * yet and total time spent releasing buffers in nanoseconds
+         */
+        void seqno_release_stats (int64_t& backlog, long long& time_ns) const;
 
         /*!
          * Returns smallest seqno present in history
          */
         int64_t seqno_min() const
         {
-            gu::Lock lock(mtx);
+            gu::Lock lock(seqno_mtx);
             if (gu_likely(!seqno2ptr.empty()))
-                return seqno2ptr.begin()->first;
+                return seqno2ptr.index_begin();
             else
                 return -1;
         }
@@ -208,12 +218,13 @@ namespace gcache
         }
             params;
 
-        gu::Mutex       mtx;
+        /* Lock order: mtx -> seqno_mtx. lock_mtx is never taken with
+         * the other two. */
+        gu::Mutex       mtx;       // stores, allocation, seqno_released
+        gu::Mutex       seqno_mtx; // seqno2ptr, seqno_max
+        gu::Mutex       lock_mtx;  // seqno_locked
         gu::Cond        cond;
 
-        typedef std::map<int64_t, const void*>  seqno2ptr_t;
-        typedef seqno2ptr_t::iterator           seqno2ptr_iter_t;
-        typedef std::pair<int64_t, const void*> seqno2ptr_pair_t;
         seqno2ptr_t     seqno2ptr;
 
         MemStore        mem;
@@ -227,6 +238,8 @@ namespace gcache
         int64_t         seqno_locked;
         int64_t         seqno_max;
         int64_t         seqno_released;
+        int64_t         release_target; // highest seqno requested for release
+        long long       release_ns;     // time spent in seqno_release()
 
 
 #ifndef NDEBUG
@@ -235,8 +248,12 @@ namespace gcache
 
         void constructor_common();
 
-        /* returns true when successfully discards all seqnos up to s */
-        bool discard_seqno (int64_t s);
+        /* returns true when successfully discards all seqnos up to s,
+         * gives up after discarding max buffers */
+        bool discard_seqno (int64_t s, size_t max);
+
+        /* moves history lock to seqno_g */
+        void seqno_lock_common (int64_t seqno_g);
 
         // disable copying
         GCache (const GCache&);
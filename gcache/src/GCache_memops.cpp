@@ -9,20 +9,21 @@
 namespace gcache
 {
     bool
-    GCache::discard_seqno (int64_t seqno)
+    GCache::discard_seqno (int64_t seqno, size_t max)
     {
-        for (seqno2ptr_t::iterator i = seqno2ptr.begin();
-             i != seqno2ptr.end() && i->first <= seqno;)
+        for (; !seqno2ptr.empty() && seqno2ptr.index_begin() <= seqno; --max)
         {
-            BufferHeader* bh(ptr2BH (i->second));
+            if (gu_unlikely(0 == max)) return false;
+
+            BufferHeader* bh(ptr2BH (seqno2ptr.front()));
 
             if (gu_likely(BH_is_released(bh)))
             {
-                assert (bh->seqno_g == i->first);
+                assert (bh->seqno_g == seqno2ptr.index_begin());
                 assert (bh->seqno_g <= seqno);
                 assert (bh->seqno_g <= seqno_released);
 
-                seqno2ptr.erase (i++); // post ++ is significant!
+                seqno2ptr.pop_front();
 
                 bh->seqno_g = SEQNO_ILL; // will never be reused
 
@@ -57,6 +58,7 @@ namespace gcache
             size_type const size(s + sizeof(BufferHeader));
 
             gu::Lock lock(mtx);
+            gu::Lock seqno_lock(seqno_mtx); // stores may discard history
 
             mallocs++;
 
@@ -113,7 +115,13 @@ namespace gcache
         case BUFFER_IN_PAGE:
             if (gu_likely(bh->seqno_g > 0))
             {
-                discard_seqno (bh->seqno_g);
+                /* Released buffers in front of this one may be many, so
+                 * discard them in batches. Whatever is left will be
+                 * discarded by the following calls. */
+                static size_t const DISCARD_BATCH(1024);
+
+                gu::Lock lock(seqno_mtx);
+                discard_seqno (bh->seqno_g, DISCARD_BATCH);
             }
             else
             {
@@ -170,6 +178,7 @@ namespace gcache
         }
 
         gu::Lock      lock(mtx);
+        gu::Lock      seqno_lock(seqno_mtx); // stores may discard history
 
         reallocs++;
 
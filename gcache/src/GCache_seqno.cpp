@@ -6,10 +6,13 @@
 #include "gcache_bh.hpp"
 #include "GCache.hpp"
 
+#include <gu_time.h>
+#include <gu_event_trace.hpp>
+
 #include <cerrno>
 #include <cassert>
+#include <algorithm>
 
-#include <sched.h> // sched_yeild()
 
 namespace gcache
 {
@@ -21,8 +24,10 @@ namespace gcache
     GCache::seqno_reset ()
     {
         gu::Lock lock(mtx);
+        gu::Lock seqno_lock(seqno_mtx);
 
         seqno_released = SEQNO_NONE;
+        release_target = SEQNO_NONE;
 
         if (gu_unlikely(seqno2ptr.empty())) return;
 
@@ -41,7 +46,7 @@ namespace gcache
                           int64_t     const seqno_g,
                           int64_t     const seqno_d)
     {
-        gu::Lock lock(mtx);
+        gu::Lock lock(seqno_mtx);
 
         BufferHeader* bh = ptr2BH(ptr);
 
@@ -51,20 +56,17 @@ namespace gcache
 
         if (gu_likely(seqno_g > seqno_max))
         {
-            seqno2ptr.insert (seqno2ptr.end(), seqno2ptr_pair_t(seqno_g, ptr));
+            seqno2ptr.insert (seqno_g, ptr);
             seqno_max = seqno_g;
         }
         else
         {
             // this should never happen. seqnos should be assinged in TO.
-            const std::pair<seqno2ptr_iter_t, bool>& res(
-                seqno2ptr.insert (seqno2ptr_pair_t(seqno_g, ptr)));
-
-            if (false == res.second)
+            if (false == seqno2ptr.insert (seqno_g, ptr))
             {
                 gu_throw_fatal <<"Attempt to reuse the same seqno: " << seqno_g
                                <<". New ptr = " << ptr << ", previous ptr = "
-                               << res.first->second;
+                               << seqno2ptr.find(seqno_g);
             }
         }
 
@@ -72,93 +74,105 @@ namespace gcache
         bh->seqno_d = seqno_d;
     }
 
-    void
-    GCache::seqno_release (int64_t const seqno)
+    bool
+    GCache::seqno_release (int64_t const seqno, long long const slice_ns)
     {
         assert (seqno > 0);
         /* The number of buffers scheduled for release is unpredictable, so
-         * we want to allow some concurrency in cache access by releasing
-         * buffers in small batches */
-        static int const min_batch_size(32);
-
-        /* Although extremely unlikely, theoretically concurrent access may
-         * lead to elements being added faster than released. The following is
-         * to control and possibly disable concurrency in that case. We start
-         * with min_batch_size and increase it if necessary. */
-        size_t old_gap(-1);
-        int    batch_size(min_batch_size);
-
-        bool   loop(false);
-
-        do
+         * to never hold up allocations in other threads for long we release
+         * buffers one by one, taking the allocation lock for each. The next
+         * buffer is looked up by seqno, since free_common() may trim the
+         * index while the lock is not held. */
+        long long const start(gu_time_monotonic());
+        int64_t s(SEQNO_NONE);
+
+        for (bool first(true);; first = false)
         {
-            /* if we're doing this loop repeatedly, allow other threads to run*/
-            if (loop) sched_yield();
-
             gu::Lock lock(mtx);
 
-            assert(seqno >= seqno_released);
+            assert(!first || seqno >= seqno_released);
 
-            seqno2ptr_iter_t it(seqno2ptr.upper_bound(seqno_released));
+            if (first && seqno > release_target) release_target = seqno;
+
+            const void* ptr(NULL);
 
-            if (gu_unlikely(it == seqno2ptr.end()))
             {
-                /* This means that there are no element with
-                 * seqno following seqno_released - and this should not
-                 * generally happen. But it looks like stopcont test does it. */
-                if (0 != seqno_released)
+                gu::Lock seqno_lock(seqno_mtx);
+
+                s = seqno2ptr.upper_bound(std::max(s, seqno_released));
+
+                if (gu_unlikely(s == seqno2ptr.index_end()))
+                {
+                    /* This means that there are no element with
+                     * seqno following seqno_released - and this should not
+                     * generally happen. But it looks like stopcont test does
+                     * it. */
+                    if (first && 0 != seqno_released)
+                    {
+                        log_debug << "Releasing seqno " << seqno << " before "
+                                  << seqno_released + 1 << " was assigned.";
+                    }
+                }
+                else if (s <= seqno)
                 {
-                    log_debug << "Releasing seqno " << seqno << " before "
-                              << seqno_released + 1 << " was assigned.";
+                    ptr = seqno2ptr.find(s);
                 }
-                return;
             }
 
-            assert(seqno_max >= seqno_released);
-
-            /* here we check if (seqno_max - seqno_released) is decreasing
-             * and if not - increase the batch_size (linearly) */
-            size_t const new_gap(seqno_max - seqno_released);
-            batch_size += (new_gap >= old_gap) * min_batch_size;
-            old_gap = new_gap;
-
-            int64_t const start(it->first - 1);
-            int64_t const end  (seqno - start >= 2*batch_size ?
-                                start + batch_size : seqno);
-#if 0
-            log_info << "############ releasing " << (seqno - start)
-                     << " buffers, batch_size: " << batch_size
-                     << ", end: " << end;
-#endif
-            for (;(loop = (it != seqno2ptr.end())) && it->first <= end;)
+            if (NULL == ptr)
             {
-                assert(it->first != SEQNO_NONE);
-                BufferHeader* const bh(ptr2BH(it->second));
-                assert (bh->seqno_g == it->first);
+                release_ns += gu_time_monotonic() - start;
+                return true;
+            }
+
+            BufferHeader* const bh(ptr2BH(ptr));
+            assert (bh->seqno_g == s);
 #ifndef NDEBUG
-                if (!(seqno_released + 1 == it->first ||
-                      seqno_released == SEQNO_NONE))
+            if (!(seqno_released + 1 == s || seqno_released == SEQNO_NONE))
+            {
+                log_info << "seqno_released: " << seqno_released
+                         << "; s: " << s << "; seqno: " << seqno;
+                assert(seqno_released + 1 == s ||
+                       seqno_released == SEQNO_NONE);
+            }
+#endif
+            if (gu_likely(!BH_is_released(bh))) free_common(bh);
+
+            gu::EventTrace::record(gu::EventTrace::GCACHE_RELEASE, s);
+
+            /* at least one buffer per call, so that progress is guaranteed */
+            if (slice_ns > 0 && s < seqno)
+            {
+                long long const elapsed(gu_time_monotonic() - start);
+
+                if (elapsed >= slice_ns)
                 {
-                    log_info << "seqno_released: " << seqno_released
-                             << "; it->first: " << it->first
-                             << "; seqno2ptr.begin: " <<seqno2ptr.begin()->first
-                             << "\nstart: " << start << "; end: " << end
-                             << " batch_size: " << batch_size << "; gap: "
-                             << new_gap << "; seqno_max: " << seqno_max;
-                    assert(seqno_released + 1 == it->first ||
-                           seqno_released == SEQNO_NONE);
+                    release_ns += elapsed;
+                    return false;
                 }
-#endif
-                ++it; /* free_common() below may erase current element,
-                       * so advance iterator before calling free_common()*/
-                if (gu_likely(!BH_is_released(bh))) free_common(bh);
             }
+        }
+    }
+
+    void
+    GCache::seqno_release_stats (int64_t& backlog, long long& time_ns) const
+    {
+        gu::Lock lock(mtx);
+
+        backlog = std::max<int64_t>(release_target - seqno_released, 0);
+        time_ns = release_ns;
+    }
 
-            assert (loop || seqno == seqno_released);
+    void
+    GCache::seqno_lock_common (int64_t const seqno_g)
+    {
+        gu::Lock lock(lock_mtx);
 
-            loop = (end < seqno) && loop;
+        if (seqno_locked != SEQNO_NONE)
+        {
+            cond.signal();
         }
-        while(loop);
+        seqno_locked = seqno_g;
     }
 
     /*!
@@ -167,15 +181,13 @@ namespace gcache
      */
     void GCache::seqno_lock (int64_t const seqno_g)
     {
-        gu::Lock lock(mtx);
-
-        if (seqno2ptr.find(seqno_g) == seqno2ptr.end()) throw gu::NotFound();
-
-        if (seqno_locked != SEQNO_NONE)
         {
-            cond.signal();
+            gu::Lock lock(seqno_mtx);
+
+            if (seqno2ptr.find(seqno_g) == NULL) throw gu::NotFound();
         }
-        seqno_locked = seqno_g;
+
+        seqno_lock_common(seqno_g);
     }
 
     /*!
@@ -190,26 +202,15 @@ namespace gcache
         const void* ptr(0);
 
         {
-            gu::Lock lock(mtx);
+            gu::Lock lock(seqno_mtx);
 
-            seqno2ptr_iter_t p = seqno2ptr.find(seqno_g);
+            ptr = seqno2ptr.find(seqno_g);
 
-            if (p != seqno2ptr.end())
-            {
-                if (seqno_locked != SEQNO_NONE)
-                {
-                    cond.signal();
-                }
-                seqno_locked = seqno_g;
-
-                ptr = p->second;
-            }
-            else
-            {
-                throw gu::NotFound();
-            }
+            if (ptr == NULL) throw gu::NotFound();
         }
 
+        seqno_lock_common(seqno_g);
+
         assert (ptr);
 
         const BufferHeader* const bh (ptr2BH(ptr)); // this can result in IO
@@ -230,30 +231,23 @@ namespace gcache
         size_t found(0);
 
         {
-            gu::Lock lock(mtx);
+            gu::Lock lock(seqno_mtx);
 
-            seqno2ptr_iter_t p = seqno2ptr.find(start);
+            const void* p(seqno2ptr.find(start));
 
-            if (p != seqno2ptr.end())
+            if (p != NULL)
             {
-                if (seqno_locked != SEQNO_NONE)
-                {
-                    cond.signal();
-                }
-
-                seqno_locked = start;
-
                 do {
-                    assert (p->first == int64_t(start + found));
-                    assert (p->second);
-                    v[found].set_ptr(p->second);
+                    v[found].set_ptr(p);
                 }
-                while (++found < max && ++p != seqno2ptr.end() &&
-                       p->first == int64_t(start + found));
+                while (++found < max &&
+                       (p = seqno2ptr.find(start + found)) != NULL);
                 /* the latter condition ensures seqno continuty, #643 */
             }
         }
 
+        if (found > 0) seqno_lock_common(start);
+
         // the following may cause IO
         for (size_t i(0); i < found; ++i)
         {
@@ -275,7 +269,7 @@ namespace gcache
      */
     void GCache::seqno_unlock ()
     {
-        gu::Lock lock(mtx);
+        gu::Lock lock(lock_mtx);
         seqno_locked = SEQNO_NONE;
         cond.signal();
     }
@@ -10,6 +10,7 @@
 
 #include <gu_logger.hpp>
 #include <gu_throw.hpp>
+#include <gu_thread_affinity.hpp>
 
 #include <cstdio>
 #include <cstring>
@@ -52,6 +53,8 @@ remove_file (void* __restrict__ arg)
 {
     char* const file_name (static_cast<char*>(arg));
 
+    gu::ThreadAffinity::apply(gu::ThreadAffinity::GCACHE);
+
     if (NULL != file_name)
     {
         if (remove (file_name))
@@ -39,7 +39,7 @@ namespace gcache
     RingBuffer::constructor_common() {}
 
     RingBuffer::RingBuffer (const std::string& name, size_t size,
-                            std::map<int64_t, const void*> & seqno2ptr)
+                            seqno2ptr_t& seqno2ptr)
     :
         fd_        (name, check_size(size)),
         mmap_      (fd_),
@@ -73,15 +73,13 @@ namespace gcache
     bool
     RingBuffer::discard_seqno (int64_t seqno)
     {
-        for (seqno2ptr_t::iterator i = seqno2ptr_.begin();
-             i != seqno2ptr_.end() && i->first <= seqno;)
+        while (!seqno2ptr_.empty() && seqno2ptr_.index_begin() <= seqno)
         {
-            seqno2ptr_t::iterator j(i); ++i;
-            BufferHeader* const bh (ptr2BH (j->second));
+            BufferHeader* const bh (ptr2BH (seqno2ptr_.front()));
 
             if (gu_likely (BH_is_released(bh)))
             {
-                seqno2ptr_.erase (j);
+                seqno2ptr_.pop_front();
                 bh->seqno_g = SEQNO_ILL;  // will never be accessed by seqno
 
                 switch (bh->store)
@@ -343,17 +341,20 @@ namespace gcache
          * end of released buffers chain. */
         BufferHeader* bh(0);
 
-        for (seqno2ptr_t::reverse_iterator r(seqno2ptr_.rbegin());
-             r != seqno2ptr_.rend(); ++r)
+        for (int64_t s(seqno2ptr_.index_end() - 1);
+             !seqno2ptr_.empty() && s >= seqno2ptr_.index_begin(); --s)
         {
-            BufferHeader* const b(ptr2BH(r->second));
+            const void* const ptr(seqno2ptr_.find(s));
+            if (!ptr) continue;
+
+            BufferHeader* const b(ptr2BH(ptr));
             if (BUFFER_IN_RB == b->store)
             {
 #ifndef NDEBUG
                 if (!BH_is_released(b))
                 {
                     log_fatal << "Buffer "
-                              << reinterpret_cast<const void*>(r->second)
+                              << ptr
                               << ", seqno_g " << b->seqno_g << ", seqno_d "
                               << b->seqno_d << " is not released.";
                     assert(0);
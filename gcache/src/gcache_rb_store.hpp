@@ -13,8 +13,9 @@
 #include <gu_fdesc.hpp>
 #include <gu_mmap.hpp>
 
+#include "gcache_seqno2ptr.hpp"
+
 #include <string>
-#include <map>
 #include <stdint.h>
 
 namespace gcache
@@ -24,7 +25,7 @@ namespace gcache
     public:
 
         RingBuffer (const std::string& name, size_t size,
-                    std::map<int64_t, const void*>& seqno2ptr);
+                    seqno2ptr_t& seqno2ptr);
 
         ~RingBuffer ();
 
@@ -52,6 +53,9 @@ namespace gcache
 
         void  seqno_reset();
 
+        /*! faults in all pages of the buffer in the calling thread */
+        void  prefault() const { mmap_.prefault(); }
+
         /* returns true when successfully discards all seqnos up to s */
         bool  discard_seqno  (int64_t s);
 
@@ -121,8 +125,6 @@ namespace gcache
         size_t             size_used_;
         size_t             size_trail_;
 
-        typedef std::map<int64_t, const void*> seqno2ptr_t;
-
         seqno2ptr_t&    seqno2ptr_;
 
         BufferHeader*   get_new_buffer (size_type size);
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+/*! @file seqno to buffer pointer map */
+
+#ifndef _gcache_seqno2ptr_hpp_
+#define _gcache_seqno2ptr_hpp_
+
+#include <gu_macros.h> // gu_likely()
+#include <gu_throw.hpp>
+
+#include <deque>
+#include <cassert>
+#include <cstddef> // NULL
+#include <stdint.h>
+
+namespace gcache
+{
+    /*!
+     * Seqno-indexed map of buffer pointers.
+     *
+     * Seqnos are assigned in order and without gaps (save for rare
+     * exceptions), so pointers are kept in a deque indexed by the offset from
+     * the first seqno: insert at the back, lookup and trim from the front are
+     * O(1) and cost 8 bytes per entry. Missing seqnos are represented by NULL
+     * entries. The first entry, if any, is never NULL. Since memory is
+     * proportional to the span of seqnos, a gap wider than MAX_GAP is
+     * refused.
+     */
+    class Seqno2Ptr
+    {
+    public:
+
+        typedef const void* value_type;
+
+        /*! maximum number of missing seqnos insert() may have to fill */
+        static int64_t const MAX_GAP = 1 << 20;
+
+        Seqno2Ptr() : begin_(0), map_() {}
+
+        bool    empty() const { return map_.empty(); }
+
+        /*! first seqno in the map, only meaningful when not empty() */
+        int64_t index_begin() const { return begin_; }
+
+        /*! seqno following the last one in the map */
+        int64_t index_end() const { return begin_ + map_.size(); }
+
+        /*! pointer for the first seqno in the map, must not be empty() */
+        value_type front() const
+        {
+            assert(!empty());
+            return map_.front();
+        }
+
+        /*! returns NULL if seqno is not in the map */
+        value_type find(int64_t const seqno) const
+        {
+            if (seqno >= begin_ && seqno < index_end())
+                return map_[seqno - begin_];
+            else
+                return NULL;
+        }
+
+        /*! the smallest seqno greater than given which is in the map,
+         *  index_end() if none */
+        int64_t upper_bound(int64_t const seqno) const
+        {
+            int64_t s(seqno < begin_ ? begin_ : seqno + 1);
+
+            while (s < index_end() && NULL == map_[s - begin_]) ++s;
+
+            return (s < index_end() ? s : index_end());
+        }
+
+        /*!
+         * Inserts pointer at seqno. Seqnos following the last one can be
+         * inserted at any time; others only in place of missing entries.
+         * @return false if seqno is already occupied
+         * @throws gu::Exception if seqno is more than MAX_GAP away from
+         *         the map
+         */
+        bool insert(int64_t const seqno, value_type const ptr)
+        {
+            assert(ptr);
+
+            if (gu_likely(seqno == index_end() && !empty()))
+            {
+                map_.push_back(ptr);
+            }
+            else if (empty())
+            {
+                begin_ = seqno;
+                map_.push_back(ptr);
+            }
+            else if (seqno >= index_end())
+            {
+                check_gap(seqno, seqno - index_end());
+                map_.resize(seqno - begin_, value_type(NULL));
+                map_.push_back(ptr);
+            }
+            else if (seqno < begin_)
+            {
+                check_gap(seqno, begin_ - seqno - 1);
+                map_.insert(map_.begin(), begin_ - seqno, value_type(NULL));
+                begin_ = seqno;
+                map_.front() = ptr;
+            }
+            else if (NULL == map_[seqno - begin_])
+            {
+                map_[seqno - begin_] = ptr;
+            }
+            else
+            {
+                return false;
+            }
+
+            return true;
+        }
+
+        /*! removes the first entry and any missing ones that follow it */
+        void pop_front()
+        {
+            assert(!empty());
+
+            do
+            {
+                map_.pop_front();
+                ++begin_;
+            }
+            while (!empty() && NULL == map_.front());
+        }
+
+        void clear() { map_.clear(); begin_ = 0; }
+
+    private:
+
+        void check_gap(int64_t const seqno, int64_t const gap) const
+        {
+            if (gu_unlikely(gap > MAX_GAP))
+            {
+                gu_throw_fatal << "Seqno " << seqno << " is " << gap
+                               << " seqnos away from the cached range ["
+                               << begin_ << ", " << index_end() << ")";
+            }
+        }
+
+        int64_t                begin_;
+        std::deque<value_type> map_;
+    };
+
+    typedef Seqno2Ptr seqno2ptr_t;
+}
+
+#endif /* _gcache_seqno2ptr_hpp_ */
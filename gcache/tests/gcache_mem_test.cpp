@@ -15,7 +15,7 @@ START_TEST(test1)
     ssize_t const bh_size (sizeof(gcache::BufferHeader));
     ssize_t const mem_size (3 + 2*bh_size);
 
-    std::map<int64_t, const void*> s2p;
+    seqno2ptr_t s2p;
     MemStore ms(mem_size, s2p);
 
     void* buf1 = ms.malloc (1 + bh_size);
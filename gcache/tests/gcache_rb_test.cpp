@@ -16,7 +16,7 @@ START_TEST(test1)
     size_t const bh_size = sizeof(gcache::BufferHeader);
     size_t const rb_size (4 + 2*bh_size);
 
-    std::map<int64_t, const void*> s2p;
+    seqno2ptr_t s2p;
     RingBuffer rb(rb_name, rb_size, s2p);
 
     fail_if (rb.size() != rb_size, "Expected %zd, got %zd", rb_size, rb.size());
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2015 Codership Oy <info@codership.com>
+ */
+
+#include "gcache_seqno2ptr.hpp"
+#include "gcache_seqno2ptr_test.hpp"
+
+using namespace gcache;
+
+START_TEST(test1)
+{
+    char bufs[8];
+    seqno2ptr_t s2p;
+
+    fail_if (!s2p.empty());
+    fail_if (s2p.find(1) != NULL);
+
+    fail_if (!s2p.insert(3, &bufs[3]));
+    fail_if (s2p.empty());
+    fail_if (s2p.index_begin() != 3);
+    fail_if (s2p.index_end()   != 4);
+    fail_if (s2p.front() != &bufs[3]);
+
+    fail_if (!s2p.insert(4, &bufs[4]));
+    fail_if (s2p.insert(4, &bufs[5])); // occupied
+    fail_if (s2p.find(4) != &bufs[4]);
+
+    /* gap */
+    fail_if (!s2p.insert(7, &bufs[7]));
+    fail_if (s2p.index_end() != 8);
+    fail_if (s2p.find(5) != NULL);
+    fail_if (s2p.find(8) != NULL);
+    fail_if (s2p.upper_bound(4) != 7);
+    fail_if (s2p.upper_bound(0) != 3);
+    fail_if (s2p.upper_bound(7) != s2p.index_end());
+
+    /* out of order */
+    fail_if (!s2p.insert(5, &bufs[5]));
+    fail_if (s2p.find(5) != &bufs[5]);
+    fail_if (!s2p.insert(1, &bufs[1]));
+    fail_if (s2p.index_begin() != 1);
+    fail_if (s2p.find(2) != NULL);
+    fail_if (s2p.find(3) != &bufs[3]);
+
+    /* trimming skips missing seqnos */
+    s2p.pop_front();
+    fail_if (s2p.index_begin() != 3);
+    s2p.pop_front();
+    s2p.pop_front();
+    fail_if (s2p.index_begin() != 5);
+    s2p.pop_front();
+    fail_if (s2p.index_begin() != 7);
+    fail_if (s2p.front() != &bufs[7]);
+    s2p.pop_front();
+    fail_if (!s2p.empty());
+
+    fail_if (!s2p.insert(2, &bufs[2]));
+    fail_if (s2p.index_begin() != 2);
+    s2p.clear();
+    fail_if (!s2p.empty());
+    fail_if (s2p.find(2) != NULL);
+}
+END_TEST
+
+START_TEST(test_gap)
+{
+    char bufs[4];
+    seqno2ptr_t s2p;
+    int64_t const base(1000000000LL);
+
+    fail_if (!s2p.insert(base, &bufs[0]));
+
+    /* widest gaps allowed */
+    fail_if (!s2p.insert(base + 1 + seqno2ptr_t::MAX_GAP, &bufs[1]));
+    fail_if (!s2p.insert(base - 1 - seqno2ptr_t::MAX_GAP, &bufs[2]));
+    int64_t const begin(s2p.index_begin());
+    int64_t const end(s2p.index_end());
+
+    /* jumps beyond MAX_GAP in either direction are refused and
+     * leave the map intact */
+    try
+    {
+        s2p.insert(end + seqno2ptr_t::MAX_GAP + 1, &bufs[3]);
+        fail("Jump forward did not throw");
+    }
+    catch (gu::Exception& e) {}
+
+    try
+    {
+        s2p.insert(begin - seqno2ptr_t::MAX_GAP - 2, &bufs[3]);
+        fail("Jump backward did not throw");
+    }
+    catch (gu::Exception& e) {}
+
+    fail_if (s2p.index_begin() != begin);
+    fail_if (s2p.index_end()   != end);
+    fail_if (s2p.find(base) != &bufs[0]);
+}
+END_TEST
+
+Suite* gcache_seqno2ptr_suite()
+{
+    Suite* s = suite_create("gcache::Seqno2Ptr");
+    TCase* tc;
+
+    tc = tcase_create("test");
+    tcase_add_test(tc, test1);
+    tcase_add_test(tc, test_gap);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
@@ -13,6 +13,7 @@
 #include "gcache_mem_test.hpp"
 #include "gcache_rb_test.hpp"
 #include "gcache_page_test.hpp"
+#include "gcache_seqno2ptr_test.hpp"
 
 extern "C" {
 #include <check.h>
@@ -25,6 +26,7 @@ static suite_creator_t suites[] =
     gcache_mem_suite,
     gcache_rb_suite,
     gcache_page_suite,
+    gcache_seqno2ptr_suite,
     0
 };
 
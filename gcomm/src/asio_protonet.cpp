@@ -30,13 +30,17 @@ gcomm::AsioProtonet::AsioProtonet(gu::Config& conf, int version)
     timer_(io_service_),
 #ifdef HAVE_ASIO_SSL_HPP
     ssl_context_(io_service_, asio::ssl::context::sslv23),
+    ssl_workers_(),
+    ssl_next_worker_(0),
 #endif // HAVE_ASIO_SSL_HPP
     mtu_(1 << 15),
     checksum_(NetHeader::checksum_type(
                   conf.get<int>(gcomm::Conf::SocketChecksum,
-                                NetHeader::CS_CRC32C)))
+                                NetHeader::CS_CRC32C))),
+    send_batch_(conf.get<size_t>(gcomm::Conf::SocketSendBatch, 1 << 16))
 {
     conf.set(gcomm::Conf::SocketChecksum, checksum_);
+    conf.set(gcomm::Conf::SocketSendBatch, send_batch_);
 #ifdef HAVE_ASIO_SSL_HPP
     // use ssl if either private key or cert file is specified
     bool use_ssl(conf_.is_set(gu::conf::ssl_key)  == true ||
@@ -53,14 +57,107 @@ gcomm::AsioProtonet::AsioProtonet(gu::Config& conf, int version)
         conf_.set(gu::conf::use_ssl, true);
         log_info << "initializing ssl context";
         gu::ssl_prepare_context(conf_, ssl_context_);
+
+        const int ssl_threads(
+            conf_.get<int>(gcomm::Conf::SocketSslThreads, 0));
+        if (ssl_threads < 0)
+        {
+            gu_throw_error(EINVAL) << "invalid value " << ssl_threads
+                                   << " for " << Conf::SocketSslThreads;
+        }
+        conf_.set(gcomm::Conf::SocketSslThreads, ssl_threads);
+        try
+        {
+            for (int i(0); i < ssl_threads; ++i)
+            {
+                ssl_workers_.push_back(new SslWorker());
+            }
+        }
+        catch (...)
+        {
+            stop_ssl_workers(); // destructor won't be called
+            throw;
+        }
     }
 #endif // HAVE_ASIO_SSL_HPP
 }
 
 gcomm::AsioProtonet::~AsioProtonet()
 {
+#ifdef HAVE_ASIO_SSL_HPP
+    stop_ssl_workers();
+#endif // HAVE_ASIO_SSL_HPP
+}
+
+#ifdef HAVE_ASIO_SSL_HPP
+gcomm::AsioProtonet::SslWorker::SslWorker()
+    :
+    io_service_(),
+    work_      (io_service_),
+    thd_       ()
+{
+    int const err(gu_thread_create(&thd_, NULL, &SslWorker::run, this));
+    if (err != 0)
+    {
+        gu_throw_error(err) << "failed to start ssl worker thread";
+    }
+}
+
+gcomm::AsioProtonet::SslWorker::~SslWorker()
+{
+    io_service_.stop();
+    gu_thread_join(thd_, NULL);
+
+    // run socket closes posted after the thread stopped
+    io_service_.reset();
+    try
+    {
+        io_service_.poll();
+    }
+    catch (std::exception& e)
+    {
+        log_warn << "ssl worker: " << e.what();
+    }
+}
+
+void gcomm::AsioProtonet::stop_ssl_workers()
+{
+    for (std::vector<SslWorker*>::iterator i(ssl_workers_.begin());
+         i != ssl_workers_.end(); ++i)
+    {
+        delete *i;
+    }
+    ssl_workers_.clear();
+}
+
+void* gcomm::AsioProtonet::SslWorker::run(void* arg)
+{
+    SslWorker* const w(static_cast<SslWorker*>(arg));
+    for (;;)
+    {
+        try
+        {
+            w->io_service_.run();
+            break; // stopped
+        }
+        catch (std::exception& e)
+        {
+            log_error << "ssl worker: " << e.what();
+        }
+    }
+    return 0;
+}
+
+asio::io_service& gcomm::AsioProtonet::ssl_io_service()
+{
+    if (ssl_workers_.empty() == true) return io_service_;
 
+    Critical<AsioProtonet> crit(*this);
+    SslWorker* const w(ssl_workers_[ssl_next_worker_ % ssl_workers_.size()]);
+    ++ssl_next_worker_;
+    return w->io_service();
 }
+#endif // HAVE_ASIO_SSL_HPP
 
 void gcomm::AsioProtonet::enter()
 {
@@ -39,10 +39,36 @@ public:
 
 #ifdef HAVE_ASIO_SSL_HPP
     std::string get_ssl_password() const;
+    size_t ssl_workers() const { return ssl_workers_.size(); }
 #endif // HAVE_ASIO_SSL_HPP
 
 private:
 
+#ifdef HAVE_ASIO_SSL_HPP
+    // Thread running io_service for SSL sockets assigned to it. All TLS
+    // record processing for those sockets happens in this thread, socket
+    // handlers enter the protonet critical section as usual.
+    class SslWorker
+    {
+    public:
+        SslWorker();
+        ~SslWorker();
+        asio::io_service& io_service() { return io_service_; }
+    private:
+        SslWorker(const SslWorker&);
+        void operator=(const SslWorker&);
+        static void* run(void*);
+
+        asio::io_service       io_service_;
+        asio::io_service::work work_;
+        gu_thread_t            thd_;
+    };
+
+    // io_service for new SSL socket
+    asio::io_service& ssl_io_service();
+    void stop_ssl_workers();
+#endif // HAVE_ASIO_SSL_HPP
+
     friend class AsioTcpSocket;
     friend class AsioTcpAcceptor;
     friend class AsioUdpSocket;
@@ -56,10 +82,13 @@ private:
     asio::deadline_timer        timer_;
 #ifdef HAVE_ASIO_SSL_HPP
     asio::ssl::context          ssl_context_;
+    std::vector<SslWorker*>     ssl_workers_;
+    size_t                      ssl_next_worker_;
 #endif /* HAVE_ASIO_SSL_HPP */
     size_t                      mtu_;
 
     NetHeader::checksum_t       checksum_;
+    size_t                      send_batch_;
 };
 
 #endif // GCOMM_ASIO_PROTONET_HPP
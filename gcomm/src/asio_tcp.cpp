@@ -9,6 +9,25 @@
 
 #define FAILED_HANDLER(_e) failed_handler(_e, __FUNCTION__, __LINE__)
 
+#ifdef HAVE_ASIO_SSL_HPP
+typedef asio::ssl::stream<asio::ip::tcp::socket> ssl_stream_t;
+
+// Stream served by ssl worker must be closed from the worker thread
+static void close_ssl_stream(ssl_stream_t* const s)
+{
+    // close underlying transport before calling shutdown()
+    // to avoid blocking
+    s->lowest_layer().close();
+    s->shutdown();
+}
+
+static void destroy_ssl_stream(ssl_stream_t* const s)
+{
+    try { close_ssl_stream(s); } catch (...) { }
+    delete s;
+}
+#endif /* HAVE_ASIO_SSL_HPP */
+
 gcomm::AsioTcpSocket::AsioTcpSocket(AsioProtonet& net, const gu::URI& uri)
     :
     Socket       (uri),
@@ -18,6 +37,10 @@ gcomm::AsioTcpSocket::AsioTcpSocket(AsioProtonet& net, const gu::URI& uri)
     ssl_socket_  (0),
 #endif /* HAVE_ASIO_SSL_HPP */
     send_q_      (),
+    send_cbs_    (),
+#ifdef HAVE_ASIO_SSL_HPP
+    ssl_send_buf_(),
+#endif /* HAVE_ASIO_SSL_HPP */
     recv_buf_    (net_.mtu() + NetHeader::serial_size_),
     recv_offset_ (0),
     state_       (S_CLOSED),
@@ -30,6 +53,16 @@ gcomm::AsioTcpSocket::AsioTcpSocket(AsioProtonet& net, const gu::URI& uri)
 gcomm::AsioTcpSocket::~AsioTcpSocket()
 {
     log_debug << "dtor for " << id();
+#ifdef HAVE_ASIO_SSL_HPP
+    if (ssl_socket_ != 0 &&
+        &ssl_socket_->get_io_service() != &net_.io_service_)
+    {
+        // hand the stream over to its ssl worker to close and destroy
+        ssl_socket_->get_io_service().post(
+            boost::bind(&destroy_ssl_stream, ssl_socket_));
+        ssl_socket_ = 0;
+    }
+#endif /* HAVE_ASIO_SSL_HPP */
     close_socket();
 #ifdef HAVE_ASIO_SSL_HPP
     delete ssl_socket_;
@@ -68,6 +101,9 @@ void gcomm::AsioTcpSocket::failed_handler(const asio::error_code& ec,
 #ifdef HAVE_ASIO_SSL_HPP
 void gcomm::AsioTcpSocket::handshake_handler(const asio::error_code& ec)
 {
+    // with ssl worker threads this is not called from event loop
+    Critical<AsioProtonet> crit(net_);
+
     if (ec)
     {
         log_error << "handshake with remote endpoint "
@@ -171,7 +207,7 @@ void gcomm::AsioTcpSocket::connect(const gu::URI& uri)
         if (uri.get_scheme() == gu::scheme::ssl)
         {
             ssl_socket_ = new asio::ssl::stream<asio::ip::tcp::socket>(
-                net_.io_service_, net_.ssl_context_
+                net_.ssl_io_service(), net_.ssl_context_
             );
 
             ssl_socket_->lowest_layer().async_connect(
@@ -250,7 +286,7 @@ void gcomm::AsioTcpSocket::write_handler(const asio::error_code& ec,
     if (!ec)
     {
         gcomm_assert(send_q_.empty() == false);
-        gcomm_assert(send_q_.front().len() >= bytes_transferred);
+        gcomm_assert(send_q_.front().len() <= bytes_transferred);
 
         while (send_q_.empty() == false &&
                bytes_transferred >= send_q_.front().len())
@@ -263,14 +299,7 @@ void gcomm::AsioTcpSocket::write_handler(const asio::error_code& ec,
 
         if (send_q_.empty() == false)
         {
-            const Datagram& dg(send_q_.front());
-            boost::array<asio::const_buffer, 2> cbs;
-            cbs[0] = asio::const_buffer(dg.header()
-                                        + dg.header_offset(),
-                                        dg.header_len());
-            cbs[1] = asio::const_buffer(&dg.payload()[0],
-                                        dg.payload().size());
-            write_one(cbs);
+            write_queued();
         }
         else if (state_ == S_CLOSING)
         {
@@ -305,7 +334,7 @@ int gcomm::AsioTcpSocket::send(const Datagram& dg)
 
     if (net_.checksum_ != NetHeader::CS_NONE)
     {
-        hdr.set_crc32(crc32(net_.checksum_, dg), net_.checksum_);
+        hdr.set_crc32(dg.checksum(net_.checksum_), net_.checksum_);
     }
 
     send_q_.push_back(dg); // makes copy of dg
@@ -320,13 +349,7 @@ int gcomm::AsioTcpSocket::send(const Datagram& dg)
 
     if (send_q_.size() == 1)
     {
-        boost::array<asio::const_buffer, 2> cbs;
-        cbs[0] = asio::const_buffer(priv_dg.header()
-                                    + priv_dg.header_offset(),
-                                    priv_dg.header_len());
-        cbs[1] = asio::const_buffer(&priv_dg.payload()[0],
-                                    priv_dg.payload().size());
-        write_one(cbs);
+        write_queued();
     }
     return 0;
 }
@@ -532,13 +555,50 @@ void gcomm::AsioTcpSocket::read_one(boost::array<asio::mutable_buffer, 1>& mbs)
 }
 
 
-void gcomm::AsioTcpSocket::write_one(
-    const boost::array<asio::const_buffer, 2>& cbs)
+// Writes as many datagrams from the head of send_q_ as fit into
+// net_.send_batch_ bytes (but at least one) in a single operation.
+// Datagrams stay in send_q_ until write_handler() is called, so the
+// buffers remain valid for the duration of the write.
+void gcomm::AsioTcpSocket::write_queued()
 {
+    size_t len(0);
+
+    send_cbs_.clear();
+
+    for (std::deque<Datagram>::const_iterator i(send_q_.begin());
+         i != send_q_.end() &&
+             (len == 0 || len + i->len() <= net_.send_batch_); ++i)
+    {
+        send_cbs_.push_back(asio::const_buffer(i->header()
+                                               + i->header_offset(),
+                                               i->header_len()));
+        send_cbs_.push_back(asio::const_buffer(&i->payload()[0],
+                                               i->payload().size()));
+        len += i->len();
+    }
+
 #ifdef HAVE_ASIO_SSL_HPP
     if (ssl_socket_ != 0)
     {
-        async_write(*ssl_socket_, cbs,
+        // SSL stream writes only the first buffer of a sequence at a time,
+        // so gather the batch into a single buffer to have it sent in as
+        // few records as possible
+        ssl_send_buf_.resize(len);
+
+        size_t offset(0);
+        for (size_t i(0); i < send_cbs_.size(); ++i)
+        {
+            size_t const size(asio::buffer_size(send_cbs_[i]));
+            if (size > 0)
+            {
+                memcpy(&ssl_send_buf_[0] + offset,
+                       asio::buffer_cast<const void*>(send_cbs_[i]), size);
+                offset += size;
+            }
+        }
+        assert(offset == len);
+
+        async_write(*ssl_socket_, asio::buffer(ssl_send_buf_),
                     boost::bind(&AsioTcpSocket::write_handler,
                                 shared_from_this(),
                                 asio::placeholders::error,
@@ -547,7 +607,7 @@ void gcomm::AsioTcpSocket::write_one(
     else
     {
 #endif /* HAVE_ASIO_SSL_HPP */
-        async_write(socket_, cbs,
+        async_write(socket_, send_cbs_,
                     boost::bind(&AsioTcpSocket::write_handler,
                                 shared_from_this(),
                                 asio::placeholders::error,
@@ -565,10 +625,16 @@ void gcomm::AsioTcpSocket::close_socket()
 #ifdef HAVE_ASIO_SSL_HPP
         if (ssl_socket_ != 0)
         {
-            // close underlying transport before calling shutdown()
-            // to avoid blocking
-            ssl_socket_->lowest_layer().close();
-            ssl_socket_->shutdown();
+            if (&ssl_socket_->get_io_service() == &net_.io_service_)
+            {
+                close_ssl_stream(ssl_socket_);
+            }
+            else
+            {
+                ssl_socket_->get_io_service().post(
+                    boost::bind(&AsioTcpSocket::close_ssl_socket,
+                                shared_from_this()));
+            }
         }
         else
         {
@@ -581,6 +647,13 @@ void gcomm::AsioTcpSocket::close_socket()
     catch (...) { }
 }
 
+#ifdef HAVE_ASIO_SSL_HPP
+void gcomm::AsioTcpSocket::close_ssl_socket()
+{
+    try { close_ssl_stream(ssl_socket_); } catch (...) { }
+}
+#endif /* HAVE_ASIO_SSL_HPP */
+
 void gcomm::AsioTcpSocket::assign_local_addr()
 {
 #ifdef HAVE_ASIO_SSL_HPP
@@ -655,6 +728,8 @@ void gcomm::AsioTcpAcceptor::accept_handler(
     SocketPtr socket,
     const asio::error_code& error)
 {
+    Critical<AsioProtonet> crit(net_);
+
     if (!error)
     {
         AsioTcpSocket* s(static_cast<AsioTcpSocket*>(socket.get()));
@@ -672,12 +747,12 @@ void gcomm::AsioTcpAcceptor::accept_handler(
                           << s->id() << " connected, remote endpoint "
                           << s->remote_addr() << " local endpoint "
                           << s->local_addr();
+                s->state_ = Socket::S_CONNECTING;
                 s->ssl_socket_->async_handshake(
                     asio::ssl::stream<asio::ip::tcp::socket>::server,
                     boost::bind(&AsioTcpSocket::handshake_handler,
                                 s->shared_from_this(),
                                 asio::placeholders::error));
-                s->state_ = Socket::S_CONNECTING;
             }
             else
             {
@@ -704,7 +779,7 @@ void gcomm::AsioTcpAcceptor::accept_handler(
         {
             new_socket->ssl_socket_ =
                 new asio::ssl::stream<asio::ip::tcp::socket>(
-                    net_.io_service_, net_.ssl_context_);
+                    net_.ssl_io_service(), net_.ssl_context_);
             acceptor_.async_accept(new_socket->ssl_socket_->lowest_layer(),
                                    boost::bind(&AsioTcpAcceptor::accept_handler,
                                                this,
@@ -752,7 +827,7 @@ void gcomm::AsioTcpAcceptor::listen(const gu::URI& uri)
         {
             new_socket->ssl_socket_ =
                 new asio::ssl::stream<asio::ip::tcp::socket>(
-                    net_.io_service_, net_.ssl_context_);
+                    net_.ssl_io_service(), net_.ssl_context_);
             acceptor_.async_accept(new_socket->ssl_socket_->lowest_layer(),
                                    boost::bind(&AsioTcpAcceptor::accept_handler,
                                                this,
@@ -68,8 +68,11 @@ private:
     void operator=(const AsioTcpSocket&);
 
     void read_one(boost::array<asio::mutable_buffer, 1>& mbs);
-    void write_one(const boost::array<asio::const_buffer, 2>& cbs);
+    void write_queued();
     void close_socket();
+#ifdef HAVE_ASIO_SSL_HPP
+    void close_ssl_socket();
+#endif /* HAVE_ASIO_SSL_HPP */
 
     // call to assign local/remote addresses at the point where it
     // is known that underlying socket is live
@@ -82,6 +85,10 @@ private:
     asio::ssl::stream<asio::ip::tcp::socket>* ssl_socket_;
 #endif // HAVE_ASIO_SSL_HPP
     std::deque<Datagram>                      send_q_;
+    std::vector<asio::const_buffer>           send_cbs_;
+#ifdef HAVE_ASIO_SSL_HPP
+    std::vector<gu::byte_t>                   ssl_send_buf_;
+#endif // HAVE_ASIO_SSL_HPP
     std::vector<gu::byte_t>                   recv_buf_;
     size_t                                    recv_offset_;
     State                                     state_;
@@ -10,6 +10,12 @@
 #include <boost/bind.hpp>
 #include <boost/array.hpp>
 
+#include <cerrno>
+#include <cstring>
+#ifdef GCOMM_ASIO_UDP_MMSG
+#include <sys/socket.h>
+#endif // GCOMM_ASIO_UDP_MMSG
+
 
 static bool is_multicast(const asio::ip::udp::endpoint& ep)
 {
@@ -60,6 +66,12 @@ gcomm::AsioUdpSocket::AsioUdpSocket(AsioProtonet& net, const gu::URI& uri)
     target_ep_(),
     source_ep_(),
     recv_buf_((1 << 15) + NetHeader::serial_size_)
+#ifdef GCOMM_ASIO_UDP_MMSG
+    ,
+    send_q_(),
+    flush_posted_(false),
+    recv_batch_buf_(batch_size_*recv_buf_.size())
+#endif // GCOMM_ASIO_UDP_MMSG
 { }
 
 
@@ -134,14 +146,34 @@ void gcomm::AsioUdpSocket::close()
 int gcomm::AsioUdpSocket::send(const Datagram& dg)
 {
     Critical<AsioProtonet> crit(net_);
-    boost::array<asio::const_buffer, 3> cbs;
     NetHeader hdr(dg.len(), net_.version_);
 
     if (net_.checksum_ != NetHeader::CS_NONE)
     {
-        hdr.set_crc32(crc32(net_.checksum_, dg), net_.checksum_);
+        hdr.set_crc32(dg.checksum(net_.checksum_), net_.checksum_);
     }
 
+#ifdef GCOMM_ASIO_UDP_MMSG
+    // Datagrams sent during the same event loop round are passed to
+    // kernel in one sendmmsg() call from flush_handler()
+    send_q_.push_back(dg); // makes copy of dg
+    Datagram& priv_dg(send_q_.back());
+
+    priv_dg.set_header_offset(priv_dg.header_offset() -
+                              NetHeader::serial_size_);
+    serialize(hdr,
+              priv_dg.header(),
+              priv_dg.header_size(),
+              priv_dg.header_offset());
+
+    if (flush_posted_ == false)
+    {
+        net_.io_service_.post(boost::bind(&AsioUdpSocket::flush_handler,
+                                          shared_from_this()));
+        flush_posted_ = true;
+    }
+#else
+    boost::array<asio::const_buffer, 3> cbs;
     gu::byte_t buf[NetHeader::serial_size_];
     serialize(hdr, buf, sizeof(buf), 0);
     cbs[0] = asio::const_buffer(buf, sizeof(buf));
@@ -157,10 +189,102 @@ int gcomm::AsioUdpSocket::send(const Datagram& dg)
         log_warn << "Error: " << err.what();
         return err.code().value();
     }
+#endif // GCOMM_ASIO_UDP_MMSG
     return 0;
 }
 
 
+#ifdef GCOMM_ASIO_UDP_MMSG
+size_t const gcomm::AsioUdpSocket::batch_size_;
+
+void gcomm::AsioUdpSocket::flush_handler()
+{
+    Critical<AsioProtonet> crit(net_);
+
+    flush_posted_ = false;
+
+    if (state() != S_CONNECTED)
+    {
+        send_q_.clear();
+        return;
+    }
+
+    struct mmsghdr msgs[batch_size_];
+    struct iovec   iovs[2*batch_size_];
+
+    while (send_q_.empty() == false)
+    {
+        size_t const n(std::min(send_q_.size(), batch_size_));
+
+        memset(msgs, 0, n*sizeof(msgs[0]));
+
+        for (size_t i(0); i < n; ++i)
+        {
+            const Datagram& dg(send_q_[i]);
+
+            iovs[2*i].iov_base = const_cast<gu::byte_t*>(
+                dg.header() + dg.header_offset());
+            iovs[2*i].iov_len  = dg.header_len();
+            iovs[2*i + 1].iov_base = dg.payload().empty() ? 0 :
+                const_cast<gu::byte_t*>(&dg.payload()[0]);
+            iovs[2*i + 1].iov_len  = dg.payload().size();
+
+            msgs[i].msg_hdr.msg_name    = target_ep_.data();
+            msgs[i].msg_hdr.msg_namelen = target_ep_.size();
+            msgs[i].msg_hdr.msg_iov     = &iovs[2*i];
+            msgs[i].msg_hdr.msg_iovlen  = 2;
+        }
+
+        int const ret(::sendmmsg(socket_.native(), msgs, n, 0));
+
+        if (ret >= 0)
+        {
+            send_q_.erase(send_q_.begin(), send_q_.begin() + ret);
+            continue;
+        }
+
+        int const err(errno);
+
+        if (EAGAIN == err || EWOULDBLOCK == err)
+        {
+            // socket send buffer is full, keep the queue and resume
+            // when the socket becomes writable again
+            socket_.async_send(asio::null_buffers(),
+                               boost::bind(&AsioUdpSocket::write_handler,
+                                           shared_from_this(),
+                                           asio::placeholders::error));
+            flush_posted_ = true;
+            return;
+        }
+
+        if (EINTR != err)
+        {
+            // the first datagram is lost like with failed send_to(),
+            // EVS will recover it
+            log_debug << "sendmmsg(): " << ::strerror(err);
+            send_q_.pop_front();
+        }
+    }
+}
+
+void gcomm::AsioUdpSocket::write_handler(const asio::error_code& ec)
+{
+    if (ec)
+    {
+        Critical<AsioProtonet> crit(net_);
+
+        log_debug << "waiting for socket to become writable failed: "
+                  << ec.message();
+        flush_posted_ = false;
+        send_q_.clear();
+        return;
+    }
+
+    flush_handler();
+}
+#endif // GCOMM_ASIO_UDP_MMSG
+
+
 void gcomm::AsioUdpSocket::read_handler(const asio::error_code& ec,
                                         size_t bytes_transferred)
 {
@@ -170,31 +294,46 @@ void gcomm::AsioUdpSocket::read_handler(const asio::error_code& ec,
         return;
     }
 
-    if (bytes_transferred >= NetHeader::serial_size_)
     {
         Critical<AsioProtonet> crit(net_);
+
+        handle_recv(&recv_buf_[0], bytes_transferred);
+#ifdef GCOMM_ASIO_UDP_MMSG
+        recv_batch();
+#endif // GCOMM_ASIO_UDP_MMSG
+    }
+
+    async_receive();
+}
+
+
+void gcomm::AsioUdpSocket::handle_recv(const gu::byte_t* const buf,
+                                       size_t            const len)
+{
+    if (len >= NetHeader::serial_size_)
+    {
         NetHeader hdr;
         try
         {
-            unserialize(&recv_buf_[0], NetHeader::serial_size_, 0, hdr);
+            unserialize(buf, NetHeader::serial_size_, 0, hdr);
         }
         catch (gu::Exception& e)
         {
             log_warn << "hdr unserialize failed: " << e.get_errno();
             return;
         }
-        if (NetHeader::serial_size_ + hdr.len() != bytes_transferred)
+        if (NetHeader::serial_size_ + hdr.len() != len)
         {
             log_warn << "len " << hdr.len()
                      << " does not match to bytes transferred"
-                     << bytes_transferred;
+                     << len;
         }
         else
         {
             Datagram dg(
                 gu::SharedBuffer(
-                    new gu::Buffer(&recv_buf_[0] + NetHeader::serial_size_,
-                                   &recv_buf_[0] + NetHeader::serial_size_
+                    new gu::Buffer(buf + NetHeader::serial_size_,
+                                   buf + NetHeader::serial_size_
                                    + hdr.len())));
             if (net_.checksum_ == true && check_cs(hdr, dg))
             {
@@ -211,10 +350,53 @@ void gcomm::AsioUdpSocket::read_handler(const asio::error_code& ec,
     }
     else
     {
-        log_warn << "short read of " << bytes_transferred;
+        log_warn << "short read of " << len;
+    }
+}
+
+
+#ifdef GCOMM_ASIO_UDP_MMSG
+// Drains datagrams which have arrived after the one passed to
+// read_handler() without going through the reactor for each.
+void gcomm::AsioUdpSocket::recv_batch()
+{
+    size_t const buf_size(recv_buf_.size());
+
+    struct mmsghdr msgs[batch_size_];
+    struct iovec   iovs[batch_size_];
+
+    int ret;
+
+    do
+    {
+        if (state() != S_CONNECTED) return;
+
+        memset(msgs, 0, sizeof(msgs));
+
+        for (size_t i(0); i < batch_size_; ++i)
+        {
+            iovs[i].iov_base = &recv_batch_buf_[i*buf_size];
+            iovs[i].iov_len  = buf_size;
+            msgs[i].msg_hdr.msg_iov    = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        ret = ::recvmmsg(socket_.native(), msgs, batch_size_, MSG_DONTWAIT, 0);
+
+        for (int i(0); i < ret && state() == S_CONNECTED; ++i)
+        {
+            handle_recv(&recv_batch_buf_[i*buf_size], msgs[i].msg_len);
+        }
+    }
+    while (ret == static_cast<int>(batch_size_));
+
+    if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+        log_debug << "recvmmsg(): " << ::strerror(errno);
     }
-    async_receive();
 }
+#endif // GCOMM_ASIO_UDP_MMSG
+
 
 void gcomm::AsioUdpSocket::async_receive()
 {
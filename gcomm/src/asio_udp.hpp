@@ -9,6 +9,12 @@
 #include "asio_protonet.hpp"
 #include <boost/enable_shared_from_this.hpp>
 #include <vector>
+#include <deque>
+
+// Batch datagram sends and receives with sendmmsg()/recvmmsg()
+#if defined(__linux__)
+#define GCOMM_ASIO_UDP_MMSG 1
+#endif
 
 //
 // Boost enable_shared_from_this<> does not have virtual destructor,
@@ -39,6 +45,10 @@ public:
     int send(const Datagram& dg);
     void read_handler(const asio::error_code&, size_t);
     void async_receive();
+#ifdef GCOMM_ASIO_UDP_MMSG
+    void flush_handler();
+    void write_handler(const asio::error_code&);
+#endif // GCOMM_ASIO_UDP_MMSG
     size_t mtu() const;
     std::string local_addr() const;
     std::string remote_addr() const;
@@ -46,12 +56,24 @@ public:
     SocketId id() const { return &socket_; }
 
 private:
+    void handle_recv(const gu::byte_t* buf, size_t len);
+#ifdef GCOMM_ASIO_UDP_MMSG
+    void recv_batch();
+#endif // GCOMM_ASIO_UDP_MMSG
+
     AsioProtonet&            net_;
     State                    state_;
     asio::ip::udp::socket    socket_;
     asio::ip::udp::endpoint  target_ep_;
     asio::ip::udp::endpoint  source_ep_;
     std::vector<gu::byte_t>  recv_buf_;
+#ifdef GCOMM_ASIO_UDP_MMSG
+    static size_t const      batch_size_ = 16;
+
+    std::deque<Datagram>     send_q_;    // waiting for flush_handler()
+    bool                     flush_posted_; // or waiting for writability
+    std::vector<gu::byte_t>  recv_batch_buf_;
+#endif // GCOMM_ASIO_UDP_MMSG
 };
 
 #if defined(__GNUG__)
@@ -18,6 +18,10 @@ std::string const gcomm::Conf::TcpNonBlocking =
     SocketPrefix + "non_blocking";
 std::string const gcomm::Conf::SocketChecksum =
     SocketPrefix + "checksum";
+std::string const gcomm::Conf::SocketSendBatch =
+    SocketPrefix + "send_batch";
+std::string const gcomm::Conf::SocketSslThreads =
+    SocketPrefix + "ssl_threads";
 
 // GMCast
 std::string const gcomm::Conf::GMCastScheme = "gmcast";
@@ -46,6 +50,8 @@ std::string const gcomm::Conf::GMCastIsolate =
     GMCastPrefix + "isolate";
 std::string const gcomm::Conf::GMCastSegment =
     GMCastPrefix + "segment";
+std::string const gcomm::Conf::GMCastRelayFanout =
+    GMCastPrefix + "relay_fanout";
 
 // EVS
 std::string const gcomm::Conf::EvsScheme = "evs";
@@ -124,6 +130,8 @@ gcomm::Conf::register_params(gu::Config& cnf)
 
     GCOMM_CONF_ADD        (TcpNonBlocking);
     GCOMM_CONF_ADD_DEFAULT(SocketChecksum);
+    GCOMM_CONF_ADD_DEFAULT(SocketSendBatch);
+    GCOMM_CONF_ADD_DEFAULT(SocketSslThreads);
 
     GCOMM_CONF_ADD_DEFAULT(GMCastVersion);
     GCOMM_CONF_ADD        (GMCastGroup);
@@ -138,6 +146,7 @@ gcomm::Conf::register_params(gu::Config& cnf)
     GCOMM_CONF_ADD        (GMCastPeerAddr);
     GCOMM_CONF_ADD        (GMCastIsolate);
     GCOMM_CONF_ADD_DEFAULT(GMCastSegment);
+    GCOMM_CONF_ADD_DEFAULT(GMCastRelayFanout);
 
     GCOMM_CONF_ADD        (EvsVersion);
     GCOMM_CONF_ADD_DEFAULT(EvsViewForgetTimeout);
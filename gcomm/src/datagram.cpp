@@ -121,3 +121,15 @@ gcomm::crc32(gcomm::NetHeader::checksum_t const type,
     gu_throw_error(EINVAL) << "Unsupported checksum algorithm: " << type;
 }
 
+uint32_t
+gcomm::Datagram::checksum(NetHeader::checksum_t const type) const
+{
+    if (cs_type_ != type)
+    {
+        cs_      = crc32(type, *this);
+        cs_type_ = type;
+    }
+
+    return cs_;
+}
+
@@ -16,11 +16,14 @@ namespace gcomm
 
     std::string const Defaults::ProtonetVersion         = "0";
     std::string const Defaults::SocketChecksum          = "2";
+    std::string const Defaults::SocketSendBatch         = "65536";
+    std::string const Defaults::SocketSslThreads        = "0";
     std::string const Defaults::GMCastVersion           = "0";
     std::string const Defaults::GMCastTcpPort           = BASE_PORT_DEFAULT;
     std::string const Defaults::GMCastSegment           = "0";
     std::string const Defaults::GMCastTimeWait          = "PT5S";
     std::string const Defaults::GMCastPeerTimeout       = "PT3S";
+    std::string const Defaults::GMCastRelayFanout       = "0";
     std::string const Defaults::EvsViewForgetTimeout    = "PT24H";
     std::string const Defaults::EvsViewForgetTimeoutMin = "PT1S";
     std::string const Defaults::EvsInactiveCheckPeriod  = "PT0.5S";
@@ -14,11 +14,14 @@ namespace gcomm
         static std::string const ProtonetBackend          ;
         static std::string const ProtonetVersion          ;
         static std::string const SocketChecksum           ;
+        static std::string const SocketSendBatch          ;
+        static std::string const SocketSslThreads         ;
         static std::string const GMCastVersion            ;
         static std::string const GMCastTcpPort            ;
         static std::string const GMCastSegment            ;
         static std::string const GMCastTimeWait           ;
         static std::string const GMCastPeerTimeout        ;
+        static std::string const GMCastRelayFanout        ;
         static std::string const EvsViewForgetTimeout     ;
         static std::string const EvsViewForgetTimeoutMin  ;
         static std::string const EvsInactiveCheckPeriod   ;
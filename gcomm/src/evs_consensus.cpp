@@ -66,6 +66,40 @@ public:
 };
 
 
+// Compare subsets of two node lists selected by op1 and op2 respectively.
+// Equivalent to comparing node lists produced by applying SelectNodesOp
+// with for_each(), but does not copy.
+static bool equal_selected(const gcomm::evs::MessageNodeList& nl1,
+                           const gcomm::evs::SelectNodesOp&   op1,
+                           const gcomm::evs::MessageNodeList& nl2,
+                           const gcomm::evs::SelectNodesOp&   op2)
+{
+    using gcomm::evs::MessageNodeList;
+
+    MessageNodeList::const_iterator i1(nl1.begin()), i2(nl2.begin());
+    for (;;)
+    {
+        while (i1 != nl1.end() &&
+               op1.select(MessageNodeList::value(i1)) == false) ++i1;
+        while (i2 != nl2.end() &&
+               op2.select(MessageNodeList::value(i2)) == false) ++i2;
+
+        if (i1 == nl1.end() || i2 == nl2.end())
+        {
+            return (i1 == nl1.end() && i2 == nl2.end());
+        }
+
+        if (!(MessageNodeList::key(i1)   == MessageNodeList::key(i2)) ||
+            !(MessageNodeList::value(i1) == MessageNodeList::value(i2)))
+        {
+            return false;
+        }
+        ++i1;
+        ++i2;
+    }
+}
+
+
 //
 //
 //
@@ -95,28 +129,26 @@ bool gcomm::evs::Consensus::equal(const Message& m1, const Message& m2) const
         }
     }
 
-    MessageNodeList nl1, nl2;
+    // SelectNodesOp is used only as selection predicate here, node lists
+    // are compared in place to avoid copying them on every check
+    MessageNodeList unused;
 
     // When comparing messages from same source whole node list is comparable,
     // otherwise only operational part of it.
     if (m1.source() == m2.source())
     {
-        for_each(m1.node_list().begin(), m1.node_list().end(),
-                 SelectNodesOp(nl1, m1.source_view_id(), true, true));
-        for_each(m2.node_list().begin(), m2.node_list().end(),
-                 SelectNodesOp(nl2, m2.source_view_id(), true, true));
+        return equal_selected(
+            m1.node_list(), SelectNodesOp(unused, m1.source_view_id(),
+                                          true, true),
+            m2.node_list(), SelectNodesOp(unused, m2.source_view_id(),
+                                          true, true));
     }
     else
     {
-        for_each(m1.node_list().begin(), m1.node_list().end(),
-                 SelectNodesOp(nl1, ViewId(), true, false));
-        for_each(m2.node_list().begin(), m2.node_list().end(),
-                 SelectNodesOp(nl2, ViewId(), true, false));
+        return equal_selected(
+            m1.node_list(), SelectNodesOp(unused, ViewId(), true, false),
+            m2.node_list(), SelectNodesOp(unused, ViewId(), true, false));
     }
-
-    evs_log_debug(D_CONSENSUS) << "nl1: " << nl1 << " nl2: " << nl2;
-
-    return (nl1 == nl2);
 }
 
 
@@ -516,24 +548,56 @@ bool gcomm::evs::Consensus::is_consensus() const
         return false;
     }
 
+    // Cheap check first, consensus cannot be reached before join
+    // messages from all operational nodes have been received
+    for (NodeMap::const_iterator i = known_.begin(); i != known_.end(); ++i)
+    {
+        const Node& inst(NodeMap::value(i));
+        if (inst.operational() == true && inst.join_message() == 0)
+        {
+            evs_log_debug(D_CONSENSUS)
+                << "no join message for " << NodeMap::key(i);
+            return false;
+        }
+    }
+
     if (is_consistent_same_view(*my_jm) == false)
     {
         evs_log_debug(D_CONSENSUS) << "own join message not consistent";
         return false;
     }
 
+    MessageNodeList unused;
+    const SelectNodesOp same_view(unused, current_view_.id(), true, true);
+
     for (NodeMap::const_iterator i = known_.begin(); i != known_.end(); ++i)
     {
         const Node& inst(NodeMap::value(i));
         if (inst.operational() == true)
         {
             const JoinMessage* jm = inst.join_message();
-            if (jm == 0)
+            if (jm == my_jm) continue;
+
+            // Same view consistency depends only on seqs and on node list
+            // entries coming from the current view. If those are identical
+            // to own join message, which was found consistent above, full
+            // check against local state can be skipped.
+            if (jm->source_view_id() == current_view_.id() &&
+                jm->seq()            == my_jm->seq()       &&
+                jm->aru_seq()        == my_jm->aru_seq()   &&
+                equal_selected(jm->node_list(), same_view,
+                               my_jm->node_list(), same_view) == true)
             {
-                evs_log_debug(D_CONSENSUS)
-                    << "no join message for " << NodeMap::key(i);
-                return false;
+                if (equal(*jm, *my_jm) == false)
+                {
+                    evs_log_debug(D_CONSENSUS)
+                        << "join message " << *jm
+                        << " not equal to my join " << *my_jm;
+                    return false;
+                }
+                continue;
             }
+
             // call is_consistent() instead of equal() to enforce strict
             // check for messages originating from the same view (#541)
             if (is_consistent(*jm) == false)
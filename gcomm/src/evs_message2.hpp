@@ -685,18 +685,22 @@ public:
 
     void operator()(const MessageNodeList::value_type& vt) const
     {
-        const MessageNode& node(MessageNodeList::value(vt));
-        if ((view_id_                  == ViewId() ||
-             node.view_id()        == view_id_    ) &&
-            ((operational_             == true          &&
-              leaving_                 == true   ) ||
-             (node.operational() == operational_ &&
-              node.leaving()     == leaving_ ) ) )
-
+        if (select(MessageNodeList::value(vt)) == true)
         {
             nl_.insert_unique(vt);
         }
     }
+
+    // Selection criteria without copying, see also Consensus::equal()
+    bool select(const MessageNode& node) const
+    {
+        return ((view_id_                  == ViewId() ||
+                 node.view_id()        == view_id_    ) &&
+                ((operational_             == true          &&
+                  leaving_                 == true   ) ||
+                 (node.operational() == operational_ &&
+                  node.leaving()     == leaving_ ) ) );
+    }
 private:
     MessageNodeList&       nl_;
     ViewId           const view_id_;
@@ -150,6 +150,7 @@ gcomm::evs::Proto::Proto(gu::Config&    conf,
                              Defaults::EvsDelayedKeepPeriod)),
     last_inactive_check_   (gu::datetime::Date::now()),
     last_causal_keepalive_ (gu::datetime::Date::now()),
+    last_sent_join_tstamp_ (gu::datetime::Date::zero()),
     current_view_(0, ViewId(V_TRANS, my_uuid,
                          rst_view ? rst_view -> id().seq() + 1 : 0)),
     previous_view_(),
@@ -641,6 +642,15 @@ void gcomm::evs::Proto::handle_retrans_timer()
                               install_message_->install_view_id(),
                               Range(), true));
         }
+        else if (gu::datetime::Date::now() <
+                 last_sent_join_tstamp_ + join_retrans_period_)
+        {
+            // Join message reflecting current state has been sent
+            // within last retrans period, retransmission would only
+            // duplicate it. With large clusters this cuts down
+            // join traffic considerably while consensus is forming.
+            evs_log_debug(D_JOIN_MSGS) << "skip retrans join";
+        }
         else
         {
             evs_log_debug(D_JOIN_MSGS) << "retrans join";
@@ -1892,6 +1902,10 @@ void gcomm::evs::Proto::send_join(bool handle)
     {
         log_debug << "send failed: " << strerror(err);
     }
+    else
+    {
+        last_sent_join_tstamp_ = gu::datetime::Date::now();
+    }
     sent_msgs_[Message::T_JOIN]++;
     if (handle == true)
     {
@@ -2072,6 +2086,25 @@ void gcomm::evs::Proto::resend(const UUID& gap_source, const Range range)
                              << range.lu() << " -> "
                              << range.hs();
 
+    // Retransmission goes to gap_source alone only if all other operational
+    // nodes have acknowledged the range, otherwise they would each have to
+    // ask for it separately.
+    UUID target(gap_source);
+    for (NodeMap::const_iterator i(known_.begin()); i != known_.end(); ++i)
+    {
+        const UUID& node_uuid(NodeMap::key(i));
+        const Node& node(NodeMap::value(i));
+
+        if (node_uuid != uuid() && node_uuid != gap_source &&
+            node.operational() == true &&
+            node.index() != std::numeric_limits<size_t>::max() &&
+            input_map_->safe_seq(node.index()) < range.hs())
+        {
+            target = UUID::nil();
+            break;
+        }
+    }
+
     seqno_t seq(range.lu());
     while (seq <= range.hs())
     {
@@ -2113,7 +2146,8 @@ void gcomm::evs::Proto::resend(const UUID& gap_source, const Range range)
 
         push_header(um, rb);
 
-        int err = send_down(rb, ProtoDownMeta());
+        int err = send_down(rb, ProtoDownMeta(0xff, O_SAFE, UUID::nil(), 0,
+                                              target));
         if (err != 0)
         {
             log_debug << "send failed: " << strerror(err);
@@ -4055,6 +4089,7 @@ void gcomm::evs::Proto::check_unseen()
 // flag true in all present join messages, declare it inactive.
 void gcomm::evs::Proto::check_nil_view_id()
 {
+    const ViewId nil_view_id(V_REG);
     size_t join_counts(0);
     std::map<UUID, size_t > nil_counts;
     for (NodeMap::const_iterator i(known_.begin()); i != known_.end(); ++i)
@@ -4069,7 +4104,7 @@ void gcomm::evs::Proto::check_nil_view_id()
              j != jm->node_list().end(); ++j)
         {
             const MessageNode& mn(MessageNodeList::value(j));
-            if (mn.view_id() == ViewId(V_REG))
+            if (mn.view_id() == nil_view_id)
             {
                 // todo: investigate why removing mn.suspected() == true
                 // condition causes some unit tests to fail
@@ -4347,19 +4382,27 @@ void gcomm::evs::Proto::handle_join(const JoinMessage& msg, NodeMap::iterator ii
     MessageNodeList new_nl;
     populate_node_list(&new_nl);
 
-    if (curr_join == 0 ||
+    const bool join_changed(
+        curr_join == 0 ||
         (curr_join->aru_seq()   != input_map_->aru_seq()  ||
          curr_join->seq()       != input_map_->safe_seq() ||
-         curr_join->node_list() != new_nl))
+         curr_join->node_list() != new_nl));
+
+    if (join_changed == true)
     {
         gu_trace(create_join());
-        if (consensus_.is_consensus() == false)
-        {
-            send_join(false);
-        }
     }
 
-    if (consensus_.is_consensus() == true)
+    // Consensus is evaluated once, own join message created above is
+    // the only input for it which could have changed in between
+    const bool is_cons(consensus_.is_consensus());
+
+    if (join_changed == true && is_cons == false)
+    {
+        send_join(false);
+    }
+
+    if (is_cons == true)
     {
         if (is_representative(uuid()) == true)
         {
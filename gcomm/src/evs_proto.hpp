@@ -420,6 +420,7 @@ private:
 
     gu::datetime::Date last_inactive_check_;
     gu::datetime::Date last_causal_keepalive_;
+    gu::datetime::Date last_sent_join_tstamp_;
 
     // Current view id
     // ViewId current_view;
@@ -63,6 +63,22 @@ namespace gcomm
          */
         static std::string const SocketChecksum;
 
+        /*!
+         * @brief Maximum number of bytes of queued messages to be sent
+         *        to TCP socket in a single write. At least one message
+         *        is always written, so 0 disables batching.
+         */
+        static std::string const SocketSendBatch;
+
+        /*!
+         * @brief Number of threads doing TLS record encryption and
+         *        decryption for SSL sockets. Sockets are distributed
+         *        over the threads, each socket is always served by
+         *        the same thread. 0 processes TLS records in the
+         *        event loop thread.
+         */
+        static std::string const SocketSslThreads;
+
         /*!
          * @brief GMCast scheme for transport URI ("gmcast")
          */
@@ -155,6 +171,17 @@ namespace gcomm
          */
         static std::string const GMCastSegment;
 
+        /*!
+         * @brief Number of relay candidates per remote segment
+         *        ("gmcast.relay_fanout")
+         *
+         * Messages to remote segment are sent to a single peer which
+         * relays them to the rest of the segment. Relay peers are chosen
+         * among this many peers with the lowest round trip time, links
+         * that have degraded are not used. Value 0 allows all peers.
+         */
+        static std::string const GMCastRelayFanout;
+
 
         /*!
          * @brief EVS scheme for transport URI ("evs")
@@ -156,7 +156,9 @@ namespace gcomm
             header_       (),
             header_offset_(header_size_),
             payload_      (new gu::Buffer()),
-            offset_       (0)
+            offset_       (0),
+            cs_type_      (NetHeader::CS_NONE),
+            cs_           (0)
         { }
         /*!
          * @brief Construct new datagram from byte buffer
@@ -172,7 +174,9 @@ namespace gcomm
             header_       (),
             header_offset_(header_size_),
             payload_      (new gu::Buffer(buf)),
-            offset_       (offset)
+            offset_       (offset),
+            cs_type_      (NetHeader::CS_NONE),
+            cs_           (0)
         {
             assert(offset_ <= payload_->size());
         }
@@ -182,7 +186,9 @@ namespace gcomm
             header_       (),
             header_offset_(header_size_),
             payload_      (buf),
-            offset_       (offset)
+            offset_       (offset),
+            cs_type_      (NetHeader::CS_NONE),
+            cs_           (0)
         {
             assert(offset_ <= payload_->size());
         }
@@ -201,7 +207,9 @@ namespace gcomm
             // header_(dgram.header_),
             header_offset_(dgram.header_offset_),
             payload_(dgram.payload_),
-            offset_(off == std::numeric_limits<size_t>::max() ? dgram.offset_ : off)
+            offset_(off == std::numeric_limits<size_t>::max() ? dgram.offset_ : off),
+            cs_type_(NetHeader::CS_NONE),
+            cs_(0)
         {
             assert(offset_ <= dgram.len());
             memcpy(header_ + header_offset_,
@@ -216,6 +224,7 @@ namespace gcomm
 
         void normalize()
         {
+            cs_type_ = NetHeader::CS_NONE;
             const gu::SharedBuffer old_payload(payload_);
             payload_ = gu::SharedBuffer(new gu::Buffer);
             payload_->reserve(header_len() + old_payload->size() - offset_);
@@ -237,7 +246,7 @@ namespace gcomm
             offset_ = 0;
         }
 
-        gu::byte_t* header() { return header_; }
+        gu::byte_t* header() { cs_type_ = NetHeader::CS_NONE; return header_; }
         const gu::byte_t* header() const { return header_; }
         size_t header_size()   const { return header_size_; }
         size_t header_len()    const { return (header_size_ - header_offset_); }
@@ -248,6 +257,7 @@ namespace gcomm
             // assert(off <= header_size_);
             if (off > header_size_) gu_throw_fatal << "out of hdrspace";
             header_offset_ = off;
+            cs_type_ = NetHeader::CS_NONE;
         }
 
         const gu::Buffer& payload() const
@@ -259,6 +269,7 @@ namespace gcomm
         gu::Buffer& payload()
         {
             assert(payload_ != 0);
+            cs_type_ = NetHeader::CS_NONE;
             return *payload_;
         }
 
@@ -269,6 +280,15 @@ namespace gcomm
 
         size_t offset() const { return offset_; }
 
+        /*!
+         * @brief Checksum of the whole datagram
+         *
+         * The value is cached until the header or payload is accessed
+         * for modification, so sending the same datagram to several
+         * peers computes it only once.
+         */
+        uint32_t checksum(NetHeader::checksum_t type) const;
+
     private:
 
         friend uint16_t crc16(const Datagram&, size_t);
@@ -279,6 +299,8 @@ namespace gcomm
         size_t              header_offset_;
         gu::SharedBuffer    payload_;
         size_t              offset_;
+        mutable NetHeader::checksum_t cs_type_; // CS_NONE if cs_ is not valid
+        mutable uint32_t              cs_;
     };
 
     uint16_t crc16(const Datagram& dg, size_t offset = 0);
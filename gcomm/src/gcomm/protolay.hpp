@@ -171,22 +171,27 @@ public:
     ProtoDownMeta(const uint8_t user_type = 0xff,
                   const Order   order     = O_SAFE,
                   const UUID&   uuid      = UUID::nil(),
-                  const int     segment   = 0) :
+                  const int     segment   = 0,
+                  const UUID&   target    = UUID::nil()) :
         user_type_ (user_type),
         order_     (order),
         source_    (uuid),
-        segment_   (segment)
+        segment_   (segment),
+        target_    (target)
     { }
 
     uint8_t     user_type() const { return user_type_; }
     Order       order()     const { return order_;     }
     const UUID& source()    const { return source_;    }
     int         segment()   const { return segment_;   }
+    // if not nil, message is meant only for this node
+    const UUID& target()    const { return target_;    }
 private:
     const uint8_t user_type_;
     const Order   order_;
     const UUID    source_;
     const int     segment_;
+    const UUID    target_;
 };
 
 class gcomm::Protolay
@@ -81,7 +81,13 @@ gcomm::GMCast::GMCast(Protonet& net, const gu::URI& uri,
     proto_map_    (new ProtoMap()),
     relay_set_    (),
     segment_map_  (),
+    segment_relays_(),
     self_index_   (std::numeric_limits<size_t>::max()),
+    relay_fanout_ (check_range(
+                       Conf::GMCastRelayFanout,
+                       param<int>(conf_, uri, Conf::GMCastRelayFanout,
+                                  Defaults::GMCastRelayFanout),
+                       0, std::numeric_limits<int>::max())),
     time_wait_    (param<gu::datetime::Period>(
                        conf_, uri,
                        Conf::GMCastTimeWait, Defaults::GMCastTimeWait)),
@@ -199,6 +205,7 @@ gcomm::GMCast::GMCast(Protonet& net, const gu::URI& uri,
     conf_.set(Conf::GMCastMCastTTL, gu::to_string(mcast_ttl_));
     conf_.set(Conf::GMCastPeerTimeout, gu::to_string(peer_timeout_));
     conf_.set(Conf::GMCastSegment, gu::to_string<int>(segment_));
+    conf_.set(Conf::GMCastRelayFanout, gu::to_string(relay_fanout_));
 }
 
 gcomm::GMCast::~GMCast()
@@ -348,6 +355,7 @@ void gcomm::GMCast::close(bool force)
     listener_ = 0;
 
     segment_map_.clear();
+    segment_relays_.clear();
     for (ProtoMap::iterator
              i = proto_map_->begin(); i != proto_map_->end(); ++i)
     {
@@ -939,6 +947,109 @@ void gcomm::GMCast::update_addresses()
     }
     log_debug << self_string() << " self index: " << self_index_;
     log_debug << self_string() << " --- mcast tree end ---";
+
+    update_segment_relays();
+}
+
+
+namespace
+{
+    // Link whose round trip time exceeds RelayRttFactor times the best
+    // round trip time to the same segment plus RelayRttSlack is considered
+    // degraded and is not used for relaying.
+    const long long RelayRttFactor(2);
+    const long long RelayRttSlack(gu::datetime::MSec);
+
+    class CmpRtt
+    {
+    public:
+        CmpRtt(const gu::datetime::Date& now) : now_(now) { }
+        bool operator()(const gcomm::gmcast::Proto* a,
+                        const gcomm::gmcast::Proto* b) const
+        {
+            // links which have not been measured yet go last
+            const gu::datetime::Period zero(0);
+            const gu::datetime::Period ar(a->rtt(now_));
+            const gu::datetime::Period br(b->rtt(now_));
+            if (ar == zero || br == zero) return (br == zero && !(ar == zero));
+            return (ar < br);
+        }
+    private:
+        gu::datetime::Date now_;
+    };
+}
+
+
+void gcomm::GMCast::update_segment_relays()
+{
+    const gu::datetime::Date now(gu::datetime::Date::now());
+    SegmentMap relays;
+
+    for (SegmentMap::const_iterator si(segment_map_.begin());
+         si != segment_map_.end(); ++si)
+    {
+        if (si->first == segment_) continue;
+
+        const Segment& segment(si->second);
+        std::vector<Proto*> candidates;
+        candidates.reserve(segment.size());
+        for (Segment::const_iterator i(segment.begin()); i != segment.end();
+             ++i)
+        {
+            ProtoMap::iterator pi(proto_map_->find((*i)->id()));
+            if (pi != proto_map_->end())
+            {
+                candidates.push_back(ProtoMap::value(pi));
+            }
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(), CmpRtt(now));
+
+        std::set<Socket*> selected;
+        const gu::datetime::Period best(
+            candidates.empty() ? 0 : candidates.front()->rtt(now));
+        for (std::vector<Proto*>::const_iterator i(candidates.begin());
+             i != candidates.end(); ++i)
+        {
+            const gu::datetime::Period rtt((*i)->rtt(now));
+            if (relay_fanout_ > 0 &&
+                selected.size() >= static_cast<size_t>(relay_fanout_))
+            {
+                break;
+            }
+            if (rtt == gu::datetime::Period(0) ||
+                !(best*RelayRttFactor + RelayRttSlack < rtt))
+            {
+                selected.insert((*i)->socket().get());
+            }
+            else
+            {
+                log_debug << self_string() << " link to " << (*i)->remote_uuid()
+                          << " is degraded, rtt " << rtt << " best " << best;
+            }
+        }
+
+        // keep segment order so that the relay chosen by this node
+        // does not change with round trip time jitter
+        Segment& relay(relays[si->first]);
+        for (Segment::const_iterator i(segment.begin()); i != segment.end();
+             ++i)
+        {
+            if (selected.find(*i) != selected.end()) relay.push_back(*i);
+        }
+
+        SegmentMap::const_iterator old(segment_relays_.find(si->first));
+        if (old != segment_relays_.end() && old->second.empty() == false &&
+            old->second != relay)
+        {
+            log_info << self_string() << " relays for segment "
+                     << static_cast<int>(si->first) << " changed, "
+                     << old->second.size() << " -> " << relay.size()
+                     << " peers, best rtt " << best;
+        }
+    }
+
+    segment_relays_.swap(relays);
 }
 
 
@@ -1092,7 +1203,11 @@ void gcomm::GMCast::check_liveness()
         }
         else if (p->state() == Proto::S_OK)
         {
-            if (p->tstamp() + peer_timeout_*2/3 < now)
+            // keepalives are sent also to busy links at one third of
+            // peer timeout to keep round trip time estimate up to date
+            if (p->tstamp() + peer_timeout_*2/3 < now ||
+                (p->keepalive_pending() == false &&
+                 p->keepalive_sent() + peer_timeout_/3 < now))
             {
                 p->send_keepalive();
             }
@@ -1186,6 +1301,8 @@ void gcomm::GMCast::check_liveness()
         relay_set_.clear();
         relaying_ = false;
     }
+
+    update_segment_relays();
 }
 
 
@@ -1204,7 +1321,7 @@ gu::datetime::Date gcomm::GMCast::handle_timers()
 }
 
 
-void send(gcomm::Socket* s, gcomm::Datagram& dg)
+void gcomm::GMCast::send(Socket* s, Datagram& dg)
 {
     int err;
     if ((err = s->send(dg)) != 0)
@@ -1212,6 +1329,14 @@ void send(gcomm::Socket* s, gcomm::Datagram& dg)
         log_debug << "failed to send to " << s->remote_addr()
                   << ": (" << err << ") " << strerror(err);
     }
+    else
+    {
+        ProtoMap::iterator i(proto_map_->find(s->id()));
+        if (i != proto_map_->end())
+        {
+            ProtoMap::value(i)->add_tx_bytes(dg.len());
+        }
+    }
 }
 
 void gcomm::GMCast::relay(const Message& msg,
@@ -1345,6 +1470,8 @@ void gcomm::GMCast::handle_up(const void*        id,
                 return;
             }
 
+            p->add_rx_bytes(dg.len() - dg.offset());
+
             Message msg;
 
             try
@@ -1448,6 +1575,25 @@ int gcomm::GMCast::handle_down(Datagram& dg, const ProtoDownMeta& dm)
 {
     Message msg(version_, Message::T_USER_BASE, uuid(), 1, segment_);
 
+    // Message for single node is not multicast: with multicast enabled
+    // these are retransmissions of messages already lost on UDP, so they
+    // go to the target directly over TCP if it is connected.
+    if (mcast_ != 0 && dm.target() != UUID::nil())
+    {
+        for (ProtoMap::iterator i(proto_map_->begin());
+             i != proto_map_->end(); ++i)
+        {
+            Proto* const p(ProtoMap::value(i));
+            if (p->remote_uuid() == dm.target() && p->state() == Proto::S_OK)
+            {
+                gu_trace(push_header(msg, dg));
+                send(p->socket().get(), dg);
+                gu_trace(pop_header(msg, dg));
+                return 0;
+            }
+        }
+    }
+
     // handle relay set first, skip these peers below
     if (relay_set_.empty() == false)
     {
@@ -1472,14 +1618,20 @@ int gcomm::GMCast::handle_down(Datagram& dg, const ProtoDownMeta& dm)
 
         if (segment_id != segment_)
         {
-            size_t target_idx((self_index_ + segment_id) % segment.size());
+            // spread the load from local segment nodes over relay
+            // candidates, fall back to all peers if all links are degraded
+            SegmentMap::const_iterator ri(segment_relays_.find(segment_id));
+            const Segment& relays(ri != segment_relays_.end() &&
+                                  ri->second.empty() == false ?
+                                  ri->second : segment);
+            size_t target_idx((self_index_ + segment_id) % relays.size());
             msg.set_flags(msg.flags() | Message::F_SEGMENT_RELAY);
             // skip peers that are in relay set
             if (relay_set_.empty() == true ||
-                relay_set_.find(segment[target_idx]) == relay_set_.end())
+                relay_set_.find(relays[target_idx]) == relay_set_.end())
             {
                 gu_trace(push_header(msg, dg));
-                send(segment[target_idx], dg);
+                send(relays[target_idx], dg);
                 gu_trace(pop_header(msg, dg));
             }
         }
@@ -1626,6 +1778,39 @@ void gcomm::GMCast::handle_evict(const UUID& uuid)
 }
 
 
+void gcomm::GMCast::handle_get_status(gu::Status& status) const
+{
+    // comma separated list of
+    // <uuid>:<segment>:<rtt usec>:<bytes sent>:<bytes received>:<relay>
+    const gu::datetime::Date now(gu::datetime::Date::now());
+    std::ostringstream os;
+    for (ProtoMap::const_iterator i(proto_map_->begin());
+         i != proto_map_->end(); ++i)
+    {
+        const Proto& p(*ProtoMap::value(i));
+        if (p.state() != Proto::S_OK) continue;
+
+        bool is_relay(false);
+        SegmentMap::const_iterator ri(
+            segment_relays_.find(p.remote_segment()));
+        if (ri != segment_relays_.end())
+        {
+            is_relay = (std::find(ri->second.begin(), ri->second.end(),
+                                  p.socket().get()) != ri->second.end());
+        }
+
+        if (os.tellp() > 0) os << ",";
+        os << p.remote_uuid().full_str() << ":"
+           << static_cast<int>(p.remote_segment()) << ":"
+           << p.rtt(now).get_nsecs()/gu::datetime::USec << ":"
+           << p.tx_bytes() << ":"
+           << p.rx_bytes() << ":"
+           << is_relay;
+    }
+    status.insert("gmcast_links", os.str());
+}
+
+
 std::string gcomm::GMCast::handle_get_address(const UUID& uuid) const
 {
     AddrList::const_iterator ali(
@@ -1724,9 +1909,18 @@ bool gcomm::GMCast::set_param(const std::string& key, const std::string& val)
                 erase_proto(pi);
             }
             segment_map_.clear();
+            segment_relays_.clear();
         }
         return true;
     }
+    else if (key == Conf::GMCastRelayFanout)
+    {
+        relay_fanout_ = check_range(Conf::GMCastRelayFanout,
+                                    gu::from_string<int>(val),
+                                    0, std::numeric_limits<int>::max());
+        update_segment_relays();
+        return true;
+    }
     else if (key == Conf::GMCastGroup ||
              key == Conf::GMCastListenAddr ||
              key == Conf::GMCastMCastAddr ||
@@ -45,6 +45,7 @@ namespace gcomm
         void handle_stable_view(const View& view);
         void handle_evict(const UUID& uuid);
         std::string handle_get_address(const UUID& uuid) const;
+        void handle_get_status(gu::Status& status) const;
         bool set_param(const std::string& key, const std::string& val);
         // Transport interface
         const UUID& uuid() const { return my_uuid_; }
@@ -191,8 +192,13 @@ namespace gcomm
         typedef std::vector<Socket*> Segment;
         typedef std::map<uint8_t, Segment> SegmentMap;
         SegmentMap segment_map_;
+        // peers in remote segments which are used as relays for
+        // messages originating from this node, selected by round trip time
+        SegmentMap segment_relays_;
         // self index in local segment when ordered by UUID
         size_t self_index_;
+        // maximum number of relay candidates per remote segment, 0 for all
+        int    relay_fanout_;
         gu::datetime::Period time_wait_;
         gu::datetime::Period check_period_;
         gu::datetime::Period peer_timeout_;
@@ -226,6 +232,9 @@ namespace gcomm
         void update_addresses();
         //
         void check_liveness();
+        // Select relay peers for remote segments from segment_map_
+        void update_segment_relays();
+        void send(Socket* s, Datagram& dg);
         void relay(const gmcast::Message& msg, const Datagram& dg,
                    const void* exclude_id);
         // Reconnecting
@@ -29,7 +29,8 @@ std::ostream& gcomm::gmcast::operator<<(std::ostream& os, const Proto& p)
        << "st=" << gcomm::gmcast::Proto::to_string(p.state_) << ","
        << "pr=" << p.propagate_remote_ << ","
        << "tp=" << p.tp_ << ","
-       << "ts=" << p.tstamp_;
+       << "ts=" << p.tstamp_ << ","
+       << "rtt=" << p.rtt_;
     return os;
 }
 
@@ -73,6 +74,8 @@ void gcomm::gmcast::Proto::send_msg(const Message& msg)
     Datagram dg(buf);
     int ret = tp_->send(dg);
 
+    if (ret == 0) tx_bytes_ += dg.len();
+
     // @todo: This can happen during congestion, figure out how to
     // avoid terminating connection with topology change messages.
     if (ret != 0)
@@ -189,6 +192,16 @@ void gcomm::gmcast::Proto::handle_ok(const Message& hs)
     if (state_ == S_OK)
     {
         log_debug << "handshake ok: " << *this;
+
+        // reply to keepalive, update round trip time estimate
+        if (keepalive_pending_ == true)
+        {
+            gu::datetime::Period const sample(
+                gu::datetime::Date::now() - keepalive_sent_);
+            rtt_ = (rtt_ == gu::datetime::Period(0) ?
+                    sample : (rtt_*7 + sample)/8);
+            keepalive_pending_ = false;
+        }
     }
     propagate_remote_ = true;
     set_state(S_OK);
@@ -270,6 +283,13 @@ void gcomm::gmcast::Proto::send_keepalive()
     log_debug << "sending keepalive: " << *this;
     Message msg(version_, Message::T_KEEPALIVE,
                 gmcast_.uuid(), local_segment_, "");
+    // only the first of keepalives sent before the reply arrives
+    // is used for round trip time measurement
+    if (keepalive_pending_ == false)
+    {
+        keepalive_sent_    = gu::datetime::Date::now();
+        keepalive_pending_ = true;
+    }
     send_msg(msg);
 }
 
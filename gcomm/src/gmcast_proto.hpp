@@ -89,6 +89,11 @@ public:
         tp_               (tp),
         link_map_         (),
         tstamp_           (gu::datetime::Date::now()),
+        keepalive_sent_   (gu::datetime::Date::zero()),
+        keepalive_pending_(false),
+        rtt_              (0),
+        tx_bytes_         (0),
+        rx_bytes_         (0),
         gmcast_           (gmcast)
     { }
 
@@ -127,6 +132,31 @@ public:
     int version() const { return version_; }
     void set_tstamp(gu::datetime::Date ts) { tstamp_ = ts; }
     gu::datetime::Date tstamp() const { return tstamp_; }
+
+    // Time when the last keepalive was sent and whether it is still
+    // waiting for T_OK reply
+    gu::datetime::Date keepalive_sent() const { return keepalive_sent_; }
+    bool keepalive_pending() const { return keepalive_pending_; }
+
+    // Smoothed round trip time measured from keepalive replies. If the
+    // reply to outstanding keepalive is already late, the time it has been
+    // waiting is returned instead so that stalled links are noticed
+    // without waiting for the reply. Zero if not measured yet.
+    gu::datetime::Period rtt(const gu::datetime::Date& now) const
+    {
+        if (keepalive_pending_ == true && keepalive_sent_ + rtt_ < now)
+        {
+            gu::datetime::Period const waited(now - keepalive_sent_);
+            if (rtt_ < waited) return waited;
+        }
+        return rtt_;
+    }
+    gu::datetime::Period rtt() const { return rtt_; }
+
+    void add_tx_bytes(size_t n) { tx_bytes_ += n; }
+    void add_rx_bytes(size_t n) { rx_bytes_ += n; }
+    unsigned long long tx_bytes() const { return tx_bytes_; }
+    unsigned long long rx_bytes() const { return rx_bytes_; }
 private:
     friend std::ostream& operator<<(std::ostream&, const Proto&);
     Proto(const Proto&);
@@ -147,6 +177,11 @@ private:
     SocketPtr         tp_;
     LinkMap           link_map_;
     gu::datetime::Date tstamp_;
+    gu::datetime::Date keepalive_sent_;
+    bool              keepalive_pending_;
+    gu::datetime::Period rtt_;
+    unsigned long long tx_bytes_;
+    unsigned long long rx_bytes_;
     const GMCast&     gmcast_;
 };
 
@@ -624,7 +624,8 @@ static DummyNode* create_dummy_node(size_t idx,
                                     int version,
                                     const string& suspect_timeout = "PT1H",
                                     const string& inactive_timeout = "PT1H",
-                                    const string& retrans_period = "PT10M")
+                                    const string& retrans_period = "PT10M",
+                                    const string& extra_conf = "")
 {
     // reset conf to avoid stale config in case of nofork
     gu_conf = gu::Config();
@@ -644,6 +645,10 @@ static DummyNode* create_dummy_node(size_t idx,
         conf += "&" + Conf::EvsDebugLogMask + "="
             + ::getenv("EVS_DEBUG_MASK");
     }
+    if (extra_conf.empty() == false)
+    {
+        conf += "&" + extra_conf;
+    }
     list<Protolay*> protos;
     UUID uuid(static_cast<int32_t>(idx));
     protos.push_back(new DummyTransport(uuid, false));
@@ -657,6 +662,11 @@ namespace
     {
         return reinterpret_cast<Proto*>(dn->protos().back());
     }
+
+    DummyTransport* transport_from_dummy(DummyNode* dn)
+    {
+        return reinterpret_cast<DummyTransport*>(dn->protos().front());
+    }
 }
 
 
@@ -2046,6 +2056,151 @@ START_TEST(test_evs_protocol_upgrade)
 END_TEST
 
 
+// Node 1 message is lost on the way to nodes [2, n_lost + 1]: retransmission
+// is targeted only if node 2 is the only one missing it. Node 1 must have
+// learned that the others have received it, so n_lost == 1 is meant for two
+// nodes only.
+static void resend_target(size_t const n_nodes, size_t const n_lost)
+{
+    PropagationMatrix prop;
+    vector<DummyNode*> dn;
+
+    for (size_t i = 1; i <= n_nodes; ++i)
+    {
+        gu_trace(dn.push_back(create_dummy_node(i, 0)));
+    }
+
+    uint32_t max_view_seq(0);
+    for (size_t i = 0; i < n_nodes; ++i)
+    {
+        gu_trace(join_node(&prop, dn[i], i == 0 ? true : false));
+        set_cvi(dn, 0, i, max_view_seq + 1);
+        gu_trace(prop.propagate_until_cvi(false));
+        max_view_seq = get_max_view_seq(dn, 0, i);
+    }
+
+    for (size_t i = 2; i <= n_lost + 1; ++i) prop.set_loss(1, i, 0.);
+    gu_trace(send_n(dn[0], 1));
+    gu_trace(prop.propagate_until_empty());
+    for (size_t i = 2; i <= n_lost + 1; ++i) prop.set_loss(1, i, 1.);
+
+    // gap is detected and reported on the next message
+    gu_trace(send_n(dn[0], 1));
+    gu_trace(prop.propagate_until_empty());
+
+    const DummyTransport* const tp(transport_from_dummy(dn[0]));
+    if (n_lost == 1)
+    {
+        fail_unless(tp->n_targeted(dn[1]->uuid()) > 0);
+    }
+    else
+    {
+        for (size_t i = 1; i < n_nodes; ++i)
+        {
+            fail_unless(tp->n_targeted(dn[i]->uuid()) == 0,
+                        "%zu messages targeted to node %zu",
+                        tp->n_targeted(dn[i]->uuid()), i + 1);
+        }
+    }
+
+    // all nodes have delivered both messages
+    for (size_t i = 0; i < n_nodes; ++i)
+    {
+        fail_unless(dn[i]->trace().current_view_trace().msgs().size() == 2,
+                    "node %zu delivered %zu messages", i + 1,
+                    dn[i]->trace().current_view_trace().msgs().size());
+    }
+    gu_trace(check_trace(dn));
+    for_each(dn.begin(), dn.end(), DeleteObject());
+}
+
+START_TEST(test_proto_resend_target)
+{
+    log_info << "START (test_proto_resend_target)";
+    // only node 2 misses the message
+    resend_target(2, 1);
+    // nodes 2 and 3 miss the message
+    resend_target(3, 2);
+}
+END_TEST
+
+
+START_TEST(test_proto_sim_benchmark)
+{
+    log_info << "START (test_proto_sim_benchmark)";
+    const SimParams params;
+    PropagationMatrix prop;
+    vector<DummyNode*> dn;
+
+    for (size_t i = 1; i <= params.n_nodes; ++i)
+    {
+        gu_trace(dn.push_back(create_dummy_node(i, 0, "PT1H", "PT1H",
+                                                "PT0.1S", params.evs_conf)));
+    }
+
+    const PropagationStats stats(sim_benchmark(prop, dn, params, V_REG));
+    fail_unless(stats.view_changes().size() == params.n_nodes);
+    fail_unless(stats.n_delivered() == stats.n_sent()*params.n_nodes);
+    fail_unless(stats.wire_bytes() > 0);
+
+    gu_trace(check_trace(dn));
+    for_each(dn.begin(), dn.end(), DeleteObject());
+}
+END_TEST
+
+
+// Measure view change duration and join/install traffic when a single
+// node bounces in a simulated cluster. Cluster size is taken from
+// GCOMM_SIM_NODES.
+START_TEST(test_proto_sim_node_bounce)
+{
+    log_info << "START (test_proto_sim_node_bounce)";
+    SimParams params;
+    params.n_msgs = 0;
+    PropagationMatrix prop;
+    vector<DummyNode*> dn;
+
+    for (size_t i = 1; i <= params.n_nodes; ++i)
+    {
+        gu_trace(dn.push_back(create_dummy_node(i, 0, "PT1S", "PT1S",
+                                                "PT0.1S", params.evs_conf)));
+    }
+
+    gu_trace(sim_benchmark(prop, dn, params, V_REG));
+
+    const size_t last(params.n_nodes - 1);
+    uint32_t max_view_seq(get_max_view_seq(dn, 0, params.n_nodes));
+
+    prop.reset_stats();
+    for (size_t i = 0; i < last; ++i)
+    {
+        prop.split(dn[i]->index(), dn[last]->index());
+    }
+    set_cvi(dn, 0, last - 1, max_view_seq + 1);
+    set_cvi(dn, last, last, max_view_seq + 1);
+    gu_trace(prop.propagate_until_cvi(true));
+    log_info << "node " << dn[last]->uuid() << " left: " << prop.stats();
+
+    max_view_seq = get_max_view_seq(dn, 0, params.n_nodes);
+
+    prop.reset_stats();
+    for (size_t i = 0; i < last; ++i)
+    {
+        prop.merge(dn[i]->index(), dn[last]->index());
+    }
+    set_cvi(dn, 0, last, max_view_seq + 1);
+    gu_trace(prop.propagate_until_cvi(true));
+    const PropagationStats rejoin(prop.stats());
+    log_info << "node " << dn[last]->uuid() << " rejoined: " << rejoin;
+    fail_unless(rejoin.view_changes().size() == 1);
+
+    gu_trace(prop.propagate_until_empty());
+    gu_trace(check_trace(dn));
+    for_each(dn.begin(), dn.end(), DeleteObject());
+}
+END_TEST
+
+
 Suite* evs2_suite()
 {
     Suite* s = suite_create("gcomm::evs");
@@ -2217,6 +2372,20 @@ Suite* evs2_suite()
         tc = tcase_create("test_evs_protocol_upgrade");
         tcase_add_test(tc, test_evs_protocol_upgrade);
         suite_add_tcase(s, tc);
+
+        tc = tcase_create("test_proto_resend_target");
+        tcase_add_test(tc, test_proto_resend_target);
+        suite_add_tcase(s, tc);
+
+        tc = tcase_create("test_proto_sim_benchmark");
+        tcase_add_test(tc, test_proto_sim_benchmark);
+        tcase_set_timeout(tc, 60);
+        suite_add_tcase(s, tc);
+
+        tc = tcase_create("test_proto_sim_node_bounce");
+        tcase_add_test(tc, test_proto_sim_node_bounce);
+        tcase_set_timeout(tc, 60);
+        suite_add_tcase(s, tc);
     }
 
     return s;
@@ -8,8 +8,10 @@
 
 #include "gmcast.hpp"
 #include "gmcast_message.hpp"
+#include "asio_protonet.hpp"
 
 #include "gu_asio.hpp" // gu::ssl_register_params()
+#include "gu_string_utils.hpp"
 
 using namespace std;
 using namespace gcomm;
@@ -19,6 +21,7 @@ using gu::byte_t;
 using gu::Buffer;
 
 #include <check.h>
+#include <unistd.h>
 
 // Note: Not all tests are run by default as they require default port to be
 // used or listen port to be known beforehand.
@@ -255,6 +258,147 @@ START_TEST(test_gmcast_w_user_messages)
 END_TEST
 
 
+// gmcast transport which sends and counts fixed pattern messages
+class PatternUser : public Toplay
+{
+    Transport* tp_;
+    size_t     recvd_;
+    Protostack pstack_;
+    explicit PatternUser(const PatternUser&);
+    void operator=(PatternUser&);
+
+public:
+
+    PatternUser(Protonet& pnet, const std::string& remote_addr) :
+        Toplay (pnet.conf()),
+        tp_    (0),
+        recvd_ (0),
+        pstack_()
+    {
+        tp_ = Transport::create(pnet, "gmcast://" + remote_addr +
+                                "?gmcast.group=testgrp"
+                                "&gmcast.time_wait=PT0.5S"
+                                "&gmcast.listen_addr=tcp://127.0.0.1:0");
+    }
+
+    ~PatternUser() { delete tp_; }
+
+    void start()
+    {
+        tp_->connect();
+        pstack_.push_proto(tp_);
+        pstack_.push_proto(this);
+    }
+
+    void stop()
+    {
+        pstack_.pop_proto(this);
+        pstack_.pop_proto(tp_);
+        tp_->close();
+    }
+
+    void send()
+    {
+        byte_t buf[16];
+        memset(buf, 0xa5, sizeof(buf));
+
+        Datagram dg(Buffer(buf, buf + sizeof(buf)));
+        send_down(dg, ProtoDownMeta());
+    }
+
+    void handle_up(const void* cid, const Datagram& rb,
+                   const ProtoUpMeta& um)
+    {
+        byte_t buf[16];
+        memset(buf, 0xa5, sizeof(buf));
+
+        fail_unless(rb.len() == rb.offset() + sizeof(buf));
+        fail_unless(memcmp(buf, &rb.payload()[0] + rb.offset(),
+                           sizeof(buf)) == 0);
+        recvd_++;
+    }
+
+    size_t      recvd()  const { return recvd_; }
+    Protostack& pstack()       { return pstack_; }
+    std::string listen_addr() const { return tp_->listen_addr(); }
+};
+
+
+// SSL connections with TLS records processed by socket.ssl_threads workers
+START_TEST(test_gmcast_ssl_workers)
+{
+    std::string const src(__FILE__);
+    std::string const conf_dir(src.substr(0, src.rfind('/') + 1) +
+                               "../../tests/conf/");
+    std::string const key(conf_dir + "galera_key.pem");
+    std::string const cert(conf_dir + "galera_cert.pem");
+
+    fail_if(access(key.c_str(), R_OK) || access(cert.c_str(), R_OK),
+            "test certificates not found in %s", conf_dir.c_str());
+
+    gu::Config conf;
+    gu::ssl_register_params(conf);
+    gcomm::Conf::register_params(conf);
+    conf.set(gu::conf::ssl_key, key);
+    conf.set(gu::conf::ssl_cert, cert);
+
+    try
+    {
+        gu::ssl_init_options(conf);
+    }
+    catch (gu::Exception& e)
+    {
+        fail("test certificates not usable: %s", e.what());
+    }
+
+    conf.set(gcomm::Conf::SocketSslThreads, "2");
+    auto_ptr<Protonet> pnet(Protonet::create(conf));
+    fail_unless(static_cast<gcomm::AsioProtonet*>(pnet.get())->ssl_workers()
+                == 2);
+
+    {
+        gu::Config bad_conf(conf);
+        bad_conf.set(gcomm::Conf::SocketSslThreads, "-1");
+        try
+        {
+            auto_ptr<Protonet> bad_pnet(Protonet::create(bad_conf));
+            fail("negative number of ssl threads accepted");
+        }
+        catch (gu::Exception& e)
+        {
+            fail_unless(e.get_errno() == EINVAL);
+        }
+    }
+
+    PatternUser u1(*pnet, "");
+    pnet->insert(&u1.pstack());
+    u1.start();
+    pnet->event_loop(Sec/10);
+
+    PatternUser u2(*pnet, u1.listen_addr().erase(0, strlen("ssl://")));
+    pnet->insert(&u2.pstack());
+    u2.start();
+
+    for (size_t i(0); i < 300 && (u1.recvd() <= 50 || u2.recvd() <= 50); ++i)
+    {
+        u1.send();
+        u2.send();
+        pnet->event_loop(Sec/10);
+    }
+
+    fail_unless(u1.recvd() > 50, "u1 received %zu", u1.recvd());
+    fail_unless(u2.recvd() > 50, "u2 received %zu", u2.recvd());
+
+    pnet->erase(&u2.pstack());
+    pnet->erase(&u1.pstack());
+
+    u1.stop();
+    u2.stop();
+
+    pnet->event_loop(0);
+}
+END_TEST
+
 // not run by default, hard coded port
 START_TEST(test_gmcast_auto_addr)
 {
@@ -353,6 +497,62 @@ START_TEST(test_gmcast_forget)
 END_TEST
 
 
+// Link statistics and relay selection between two segments
+START_TEST(test_gmcast_segment_links)
+{
+    gu_conf_self_tstamp_on();
+    log_info << "START (test_gmcast_segment_links)";
+    gu::Config conf;
+    gu::ssl_register_params(conf);
+    gcomm::Conf::register_params(conf);
+    auto_ptr<Protonet> pnet(Protonet::create(conf));
+    Transport* tp1 = Transport::create(*pnet, "gmcast://"
+                    "?gmcast.group=test&gmcast.listen_addr=tcp://127.0.0.1:0"
+                    "&gmcast.segment=0&gmcast.peer_timeout=PT1S");
+    pnet->insert(&tp1->pstack());
+    tp1->connect();
+
+    Transport* tp2 = Transport::create(*pnet,
+                                       std::string("gmcast://")
+                                       + tp1->listen_addr().erase(
+                                           0, strlen("tcp://"))
+                  + "?gmcast.group=test&gmcast.listen_addr=tcp://127.0.0.1:0"
+                    "&gmcast.segment=1&gmcast.peer_timeout=PT1S");
+    pnet->insert(&tp2->pstack());
+    tp2->connect();
+
+    // allow time for keepalive round trips
+    pnet->event_loop(2*Sec);
+
+    gu::Status status;
+    tp1->get_status(status);
+    std::string links;
+    for (gu::Status::const_iterator i(status.begin()); i != status.end(); ++i)
+    {
+        if (i->first == "gmcast_links") links = i->second;
+    }
+    log_info << "links: " << links;
+
+    // <uuid>:<segment>:<rtt>:<tx>:<rx>:<relay>
+    std::vector<std::string> fields(gu::strsplit(links, ':'));
+    fail_unless(fields.size() == 6, "links: '%s'", links.c_str());
+    fail_unless(fields[0] == tp2->uuid().full_str());
+    fail_unless(fields[1] == "1");
+    fail_unless(gu::from_string<long long>(fields[3]) > 0);
+    fail_unless(gu::from_string<long long>(fields[4]) > 0);
+    fail_unless(fields[5] == "1");
+
+    pnet->erase(&tp2->pstack());
+    pnet->erase(&tp1->pstack());
+    tp1->close();
+    tp2->close();
+    delete tp1;
+    delete tp2;
+    pnet->event_loop(0);
+}
+END_TEST
+
+
 // not run by default, hard coded port
 START_TEST(test_trac_380)
 {
@@ -435,6 +635,11 @@ Suite* gmcast_suite()
     tcase_set_timeout(tc, 30);
     suite_add_tcase(s, tc);
 
+    tc = tcase_create("test_gmcast_ssl_workers");
+    tcase_add_test(tc, test_gmcast_ssl_workers);
+    tcase_set_timeout(tc, 40);
+    suite_add_tcase(s, tc);
+
     if (run_all_tests == true)
     {
         // not run by default, hard coded port
@@ -448,6 +653,11 @@ Suite* gmcast_suite()
     tcase_set_timeout(tc, 20);
     suite_add_tcase(s, tc);
 
+    tc = tcase_create("test_gmcast_segment_links");
+    tcase_add_test(tc, test_gmcast_segment_links);
+    tcase_set_timeout(tc, 20);
+    suite_add_tcase(s, tc);
+
     if (run_all_tests == true)
     {
         // not run by default, hard coded port
@@ -1085,7 +1085,8 @@ static DummyNode* create_dummy_node(size_t idx,
                                     const string& suspect_timeout = "PT1H",
                                     const string& inactive_timeout = "PT1H",
                                     const string& retrans_period = "PT20M",
-                                    int weight = 1)
+                                    int weight = 1,
+                                    const string& extra_conf = "")
 {
     gu::Config& gu_conf(static_gu_conf());
     gu::ssl_register_params(gu_conf);
@@ -1099,7 +1100,8 @@ static DummyNode* create_dummy_node(size_t idx,
         + Conf::EvsInstallTimeout + "=" + inactive_timeout + "&"
         + Conf::PcWeight + "=" + gu::to_string(weight) + "&"
         + Conf::EvsVersion + "=" + gu::to_string<int>(version) + "&"
-        + Conf::EvsInfoLogMask + "=" + "0x3";
+        + Conf::EvsInfoLogMask + "=" + "0x3"
+        + (extra_conf.empty() ? "" : "&" + extra_conf);
     list<Protolay*> protos;
 
     UUID uuid(static_cast<int32_t>(idx));
@@ -3846,6 +3848,31 @@ START_TEST(test_prim_after_evict)
 END_TEST
 
 
+START_TEST(test_pc_sim_benchmark)
+{
+    log_info << "START (test_pc_sim_benchmark)";
+    const SimParams params;
+    PropagationMatrix prop;
+    vector<DummyNode*> dn;
+
+    for (size_t i = 1; i <= params.n_nodes; ++i)
+    {
+        gu_trace(dn.push_back(create_dummy_node(i, 0, "PT1H", "PT1H",
+                                                "PT0.1S", 1,
+                                                params.evs_conf)));
+    }
+
+    const PropagationStats stats(sim_benchmark(prop, dn, params, V_PRIM));
+    fail_unless(stats.view_changes().size() == params.n_nodes);
+    fail_unless(stats.n_delivered() == stats.n_sent()*params.n_nodes);
+    fail_unless(stats.wire_bytes() > 0);
+
+    check_trace(dn);
+    for_each(dn.begin(), dn.end(), DeleteObject());
+}
+END_TEST
+
+
 Suite* pc_suite()
 {
     Suite* s = suite_create("gcomm::pc");
@@ -3996,6 +4023,11 @@ Suite* pc_suite()
         tc = tcase_create("test_prim_after_evict");
         tcase_add_test(tc, test_prim_after_evict);
         suite_add_tcase(s, tc);
+
+        tc = tcase_create("test_pc_sim_benchmark");
+        tcase_add_test(tc, test_pc_sim_benchmark);
+        tcase_set_timeout(tc, 60);
+        suite_add_tcase(s, tc);
     }
 
     return s;
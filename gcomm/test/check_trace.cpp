@@ -67,6 +67,51 @@ ostream& gcomm::operator<<(ostream& os, const Channel* chp)
     return (os << *chp);
 }
 
+ostream& gcomm::operator<<(ostream& os, const PropagationStats& st)
+{
+    os << "ticks: "       << st.tick()
+       << " sent: "       << st.n_sent()
+       << " delivered: "  << st.n_delivered()
+       << " throughput: " << st.throughput() << "/tick "
+       << st.throughput_wall() << "/s"
+       << " latency p50/p90/p99/max: "
+       << st.latency_percentile(50) << "/"
+       << st.latency_percentile(90) << "/"
+       << st.latency_percentile(99) << "/"
+       << st.latency_percentile(100)
+       << " view changes:";
+    for (vector<uint64_t>::const_iterator i(st.view_changes().begin());
+         i != st.view_changes().end(); ++i)
+    {
+        os << " " << *i;
+    }
+    os << " wire msgs: "  << st.wire_msgs()
+       << " wire bytes: " << st.wire_bytes()
+       << " wire lost: "  << st.wire_lost();
+    return os;
+}
+
+uint64_t gcomm::PropagationStats::latency_percentile(double p) const
+{
+    if (latencies_.empty()) return 0;
+    vector<uint64_t> sorted(latencies_);
+    sort(sorted.begin(), sorted.end());
+    size_t idx(static_cast<size_t>(p*(sorted.size() - 1)/100. + 0.5));
+    return sorted[min(idx, sorted.size() - 1)];
+}
+
+double gcomm::PropagationStats::throughput() const
+{
+    return (tick_ > 0 ? double(n_delivered_)/tick_ : 0.);
+}
+
+double gcomm::PropagationStats::throughput_wall() const
+{
+    double const secs(double((gu::datetime::Date::monotonic() - start_).get_nsecs())
+                      /gu::datetime::Sec);
+    return (secs > 0. ? n_delivered_/secs : 0.);
+}
+
 ostream& gcomm::operator<<(ostream& os, const MatrixElem& me)
 {
     return (os << "(" << me.ii() << "," << me.jj() << ")");
@@ -149,6 +194,8 @@ public:
 void gcomm::Channel::put(const Datagram& rb, const UUID& source)
 {
     Datagram dg(rb);
+    ++n_put_;
+    bytes_put_ += dg.len();
 //    if (dg.is_normalized() == false)
     //  {
     //   dg.normalize();
@@ -163,18 +210,32 @@ ChannelMsg gcomm::Channel::get()
         pair<size_t, ChannelMsg>& p(queue_.front());
         if (p.first == 0)
         {
+            if (bandwidth_ > 0)
+            {
+                // message passes the channel only after enough bandwidth
+                // credit has been accumulated for it
+                credit_ += bandwidth_;
+                if (credit_ < p.second.rb().len())
+                {
+                    return ChannelMsg(Datagram(), UUID::nil());
+                }
+                credit_ -= p.second.rb().len();
+            }
             // todo: packet loss goes here
             if (loss() < 1.)
             {
                 double rnd(double(rand())/double(RAND_MAX));
                 if (loss() < rnd)
                 {
+                    ++n_lost_;
                     queue_.pop_front();
+                    if (queue_.empty()) credit_ = 0;
                     return ChannelMsg(Datagram(), UUID::nil());
                 }
             }
             ChannelMsg ret(p.second);
             queue_.pop_front();
+            if (queue_.empty()) credit_ = 0;
             return ret;
         }
         else
@@ -194,6 +255,7 @@ gcomm::PropagationMatrix::~PropagationMatrix()
 void gcomm::PropagationMatrix::insert_tp(DummyNode* t)
 {
     gu_trace(tp_.insert_unique(make_pair(t->index(), t)));
+    t->set_stats(&stats_);
     for_each(tp_.begin(), tp_.end(), LinkOp(*t, prop_));
 }
 
@@ -215,6 +277,14 @@ void gcomm::PropagationMatrix::set_loss(const size_t ii, const size_t jj,
     ChannelMap::value(i)->set_loss(loss);
 }
 
+void gcomm::PropagationMatrix::set_bandwidth(const size_t ii, const size_t jj,
+                                             const size_t bw)
+{
+    ChannelMap::iterator i;
+    gu_trace(i = prop_.find_checked(MatrixElem(ii, jj)));
+    ChannelMap::value(i)->set_bandwidth(bw);
+}
+
 void gcomm::PropagationMatrix::split(const size_t ii, const size_t jj)
 {
     set_loss(ii, jj, 0.);
@@ -235,11 +305,18 @@ void gcomm::PropagationMatrix::expire_timers()
 }
 
 
+void gcomm::PropagationMatrix::propagate_once()
+{
+    stats_.advance();
+    for_each(prop_.begin(), prop_.end(), PropagateOp(tp_));
+}
+
+
 void gcomm::PropagationMatrix::propagate_n(size_t n)
 {
     while (n-- > 0)
     {
-        for_each(prop_.begin(), prop_.end(), PropagateOp(tp_));
+        propagate_once();
     }
 }
 
@@ -248,7 +325,7 @@ void gcomm::PropagationMatrix::propagate_until_empty()
 {
     do
     {
-        for_each(prop_.begin(), prop_.end(), PropagateOp(tp_));
+        propagate_once();
     }
     while (count_channel_msgs() > 0);
 }
@@ -256,6 +333,7 @@ void gcomm::PropagationMatrix::propagate_until_empty()
 
 void gcomm::PropagationMatrix::propagate_until_cvi(bool handle_timers)
 {
+    uint64_t const start(stats_.tick());
     bool all_in = false;
     do
     {
@@ -267,6 +345,32 @@ void gcomm::PropagationMatrix::propagate_until_cvi(bool handle_timers)
         }
     }
     while (all_in == false);
+    stats_.record_view_change(stats_.tick() - start);
+}
+
+
+gcomm::PropagationStats gcomm::PropagationMatrix::stats() const
+{
+    uint64_t msgs(0), bytes(0), lost(0);
+    for (ChannelMap::const_iterator i = prop_.begin(); i != prop_.end(); ++i)
+    {
+        msgs  += ChannelMap::value(i)->n_put();
+        bytes += ChannelMap::value(i)->bytes_put();
+        lost  += ChannelMap::value(i)->n_lost();
+    }
+    PropagationStats ret(stats_);
+    ret.set_wire(msgs, bytes, lost);
+    return ret;
+}
+
+
+void gcomm::PropagationMatrix::reset_stats()
+{
+    stats_.reset();
+    for (ChannelMap::iterator i = prop_.begin(); i != prop_.end(); ++i)
+    {
+        ChannelMap::value(i)->reset_counters();
+    }
 }
 
 
@@ -425,3 +529,116 @@ void gcomm::check_trace(const vector<DummyNode*>& nvec)
 {
     for_each(nvec.begin(), nvec.end(), CheckTraceOp(nvec));
 }
+
+
+template <typename T>
+static T sim_env(const char* name, const T& def)
+{
+    const char* const val(::getenv(name));
+    return (val != 0 ? gu::from_string<T>(val) : def);
+}
+
+gcomm::SimParams::SimParams() :
+    n_nodes  (sim_env<size_t>("GCOMM_SIM_NODES", 5)),
+    n_msgs   (sim_env<size_t>("GCOMM_SIM_MSGS", 20)),
+    latency  (sim_env<size_t>("GCOMM_SIM_LATENCY", 1)),
+    loss     (sim_env<double>("GCOMM_SIM_LOSS", 1.)),
+    bandwidth(sim_env<size_t>("GCOMM_SIM_BANDWIDTH", 0)),
+    seed     (sim_env<unsigned>("GCOMM_SIM_SEED", 4711)),
+    evs_conf (sim_env<std::string>("GCOMM_SIM_EVS_CONF", ""))
+{
+    if (n_nodes < 3 || n_nodes > 64)
+    {
+        gu_throw_error(EINVAL) << "GCOMM_SIM_NODES must be in range [3, 64]";
+    }
+    if (latency < 1)
+    {
+        gu_throw_error(EINVAL) << "GCOMM_SIM_LATENCY must be at least 1";
+    }
+}
+
+ostream& gcomm::operator<<(ostream& os, const SimParams& p)
+{
+    return (os << "nodes: "      << p.n_nodes
+            << " msgs: "      << p.n_msgs
+            << " latency: "   << p.latency
+            << " loss: "      << p.loss
+            << " bandwidth: " << p.bandwidth
+            << " seed: "      << p.seed
+            << " evs conf: '" << p.evs_conf << "'");
+}
+
+gcomm::PropagationStats gcomm::sim_benchmark(PropagationMatrix& prop,
+                                             vector<DummyNode*>& nvec,
+                                             const SimParams& params,
+                                             ViewType vt)
+{
+    srand(params.seed);
+
+    for (size_t i = 0; i < nvec.size(); ++i)
+    {
+        gu_trace(prop.insert_tp(nvec[i]));
+        for (size_t j = 0; j < i; ++j)
+        {
+            prop.set_latency(nvec[i]->index(), nvec[j]->index(),
+                             params.latency);
+            prop.set_latency(nvec[j]->index(), nvec[i]->index(),
+                             params.latency);
+            prop.set_bandwidth(nvec[i]->index(), nvec[j]->index(),
+                               params.bandwidth);
+            prop.set_bandwidth(nvec[j]->index(), nvec[i]->index(),
+                               params.bandwidth);
+        }
+        gu_trace(nvec[i]->connect(i == 0));
+
+        uint32_t seq(1);
+        for (size_t j = 0; j < i; ++j)
+        {
+            seq = max(seq, nvec[j]->trace().current_view_trace().view().id().seq() + 1);
+        }
+        for (size_t j = 0; j <= i; ++j)
+        {
+            nvec[j]->set_cvi(ViewId(vt, nvec[0]->uuid(), seq));
+        }
+        gu_trace(prop.propagate_until_cvi(true));
+    }
+
+    // Loss is applied only to user traffic phase so that join phase
+    // converges in bounded time
+    for (size_t i = 0; i < nvec.size(); ++i)
+    {
+        for (size_t j = 0; j < nvec.size(); ++j)
+        {
+            if (i != j)
+            {
+                prop.set_loss(nvec[i]->index(), nvec[j]->index(), params.loss);
+            }
+        }
+    }
+
+    for (size_t m = 0; m < params.n_msgs; ++m)
+    {
+        for (size_t i = 0; i < nvec.size(); ++i)
+        {
+            gu_trace(nvec[i]->send());
+        }
+        gu_trace(prop.propagate_n(1));
+    }
+
+    // Keep expiring timers to trigger retransmissions until all channels
+    // have been drained and every node has delivered every message.
+    // Note that sends may be refused by flow control, so the expected
+    // count is based on successfully sent messages.
+    while (prop.stats().n_delivered() < prop.stats().n_sent()*nvec.size())
+    {
+        gu_trace(prop.propagate_until_empty());
+        for (size_t i = 0; i < nvec.size(); ++i)
+        {
+            nvec[i]->handle_timers();
+        }
+    }
+
+    PropagationStats const ret(prop.stats());
+    log_info << "sim benchmark " << params << ": " << ret;
+    return ret;
+}
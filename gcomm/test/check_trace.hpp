@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <deque>
+#include <map>
 #include <functional>
 
 gu::Config& check_trace_conf();
@@ -165,11 +166,102 @@ namespace gcomm
 
     std::ostream& operator<<(std::ostream& os, const Trace& tr);
 
+    /*!
+     * Performance metrics collected by PropagationMatrix. Time is measured
+     * in propagation rounds (ticks), which makes results deterministic
+     * for a given random seed and independent of host speed.
+     */
+    class PropagationStats
+    {
+    public:
+        PropagationStats() :
+            tick_        (0),
+            sent_        (),
+            latencies_   (),
+            view_changes_(),
+            n_sent_      (0),
+            n_delivered_ (0),
+            wire_msgs_   (0),
+            wire_bytes_  (0),
+            wire_lost_   (0),
+            start_       (gu::datetime::Date::monotonic())
+        { }
+
+        void reset()
+        {
+            *this = PropagationStats();
+        }
+
+        uint64_t tick() const { return tick_; }
+        void     advance() { ++tick_; }
+
+        void record_send(const UUID& source, int64_t seq)
+        {
+            sent_[std::make_pair(source, seq)] = tick_;
+            ++n_sent_;
+        }
+
+        void record_delivery(const UUID& source, int64_t seq)
+        {
+            std::map<std::pair<UUID, int64_t>, uint64_t>::const_iterator i(
+                sent_.find(std::make_pair(source, seq)));
+            if (i != sent_.end())
+            {
+                latencies_.push_back(tick_ - i->second);
+            }
+            ++n_delivered_;
+        }
+
+        void record_view_change(uint64_t duration)
+        {
+            view_changes_.push_back(duration);
+        }
+
+        void set_wire(uint64_t msgs, uint64_t bytes, uint64_t lost)
+        {
+            wire_msgs_  = msgs;
+            wire_bytes_ = bytes;
+            wire_lost_  = lost;
+        }
+
+        uint64_t n_sent()      const { return n_sent_;      }
+        uint64_t n_delivered() const { return n_delivered_; }
+        uint64_t wire_msgs()   const { return wire_msgs_;   }
+        uint64_t wire_bytes()  const { return wire_bytes_;  }
+        uint64_t wire_lost()   const { return wire_lost_;   }
+
+        const std::vector<uint64_t>& view_changes() const
+        { return view_changes_; }
+
+        // Delivery latency percentile in ticks, p in range [0, 100]
+        uint64_t latency_percentile(double p) const;
+
+        // Deliveries per tick and per second of wall clock time
+        double throughput() const;
+        double throughput_wall() const;
+
+    private:
+        uint64_t tick_;
+        std::map<std::pair<UUID, int64_t>, uint64_t> sent_;
+        std::vector<uint64_t> latencies_;
+        std::vector<uint64_t> view_changes_;
+        uint64_t n_sent_;
+        uint64_t n_delivered_;
+        uint64_t wire_msgs_;
+        uint64_t wire_bytes_;
+        uint64_t wire_lost_;
+        gu::datetime::Date start_;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const PropagationStats& st);
+
+
     class DummyTransport : public Transport
     {
         UUID uuid_;
         std::deque<Datagram*> out_;
         bool queue_;
+        std::map<UUID, size_t> targeted_; // messages meant for single node
 
     public:
 
@@ -179,7 +271,8 @@ namespace gcomm
                       (Protonet::create(check_trace_conf())), uri),
             uuid_(uuid),
             out_(),
-            queue_(queue)
+            queue_(queue),
+            targeted_()
         {}
 
         ~DummyTransport()
@@ -217,6 +310,8 @@ namespace gcomm
 
         int handle_down(Datagram& wb, const ProtoDownMeta& dm)
         {
+            if (!(dm.target() == UUID::nil())) ++targeted_[dm.target()];
+
             if (queue_ == true)
             {
                 // assert(wb.header().size() == 0);
@@ -229,6 +324,13 @@ namespace gcomm
             }
         }
 
+        // number of messages sent down for target node only
+        size_t n_targeted(const UUID& target) const
+        {
+            std::map<UUID, size_t>::const_iterator i(targeted_.find(target));
+            return (i == targeted_.end() ? 0 : i->second);
+        }
+
         Datagram* out()
         {
             if (out_.empty())
@@ -254,7 +356,8 @@ namespace gcomm
             protos_ (protos),
             cvi_    (),
             tr_     (),
-            curr_seq_(0)
+            curr_seq_(0),
+            stats_  (0)
         {
             gcomm_assert(protos_.empty() == false);
             std::list<Protolay*>::iterator i, i_next;
@@ -285,6 +388,8 @@ namespace gcomm
 
         size_t index() const { return index_; }
 
+        void set_stats(PropagationStats* stats) { stats_ = stats; }
+
         void connect(bool first)
         {
             gu_trace(std::for_each(protos_.rbegin(), protos_.rend(),
@@ -329,6 +434,7 @@ namespace gcomm
             }
             else
             {
+                if (stats_ != 0) stats_->record_send(uuid_, seq);
                 ++curr_seq_;
             }
         }
@@ -393,6 +499,7 @@ namespace gcomm
                                           seq));
                 tr_.insert_msg(TraceMsg(um.source(), um.source_view_id(),
                                         seq));
+                if (stats_ != 0) stats_->record_delivery(um.source(), seq);
             }
             else
             {
@@ -416,6 +523,7 @@ namespace gcomm
         ViewId cvi_;
         Trace tr_;
         int64_t curr_seq_;
+        PropagationStats* stats_;
     };
 
 
@@ -447,6 +555,11 @@ namespace gcomm
             ttl_(ttl),
             latency_(latency),
             loss_(loss),
+            bandwidth_(0),
+            credit_(0),
+            n_put_(0),
+            bytes_put_(0),
+            n_lost_(0),
             queue_()
         { }
 
@@ -473,14 +586,26 @@ namespace gcomm
         size_t latency() const { return latency_; }
         void set_loss(const double l) { loss_ = l; }
         double loss() const { return loss_; }
+        // Bytes which can pass the channel per tick, 0 means unlimited
+        void set_bandwidth(const size_t b) { bandwidth_ = b; }
+        size_t bandwidth() const { return bandwidth_; }
         size_t n_msgs() const
         {
             return queue_.size();
         }
+        uint64_t n_put()     const { return n_put_;     }
+        uint64_t bytes_put() const { return bytes_put_; }
+        uint64_t n_lost()    const { return n_lost_;    }
+        void reset_counters() { n_put_ = bytes_put_ = n_lost_ = 0; }
     private:
         size_t ttl_;
         size_t latency_;
         double loss_;
+        size_t bandwidth_;
+        size_t credit_;
+        uint64_t n_put_;
+        uint64_t bytes_put_;
+        uint64_t n_lost_;
         std::deque<std::pair<size_t, ChannelMsg> > queue_;
     };
 
@@ -534,20 +659,27 @@ namespace gcomm
     class PropagationMatrix
     {
     public:
-        PropagationMatrix() : tp_(), prop_() { }
+        PropagationMatrix() : tp_(), prop_(), stats_() { }
         ~PropagationMatrix();
 
         void insert_tp(DummyNode* t);
         void set_latency(const size_t ii, const size_t jj, const size_t lat);
         void set_loss(const size_t ii, const size_t jj, const double loss);
+        void set_bandwidth(const size_t ii, const size_t jj, const size_t bw);
         void split(const size_t ii, const size_t jj);
         void merge(const size_t ii, const size_t jj, const double loss = 1.0);
         void propagate_n(size_t n);
         void propagate_until_empty();
         void propagate_until_cvi(bool handle_timers);
+
+        // Snapshot of metrics collected so far, including wire counters
+        PropagationStats stats() const;
+        void reset_stats();
+
         friend std::ostream& operator<<(std::ostream&,const PropagationMatrix&);
     private:
         void expire_timers();
+        void propagate_once();
 
 
         size_t count_channel_msgs() const;
@@ -555,6 +687,7 @@ namespace gcomm
 
         NodeMap    tp_;
         ChannelMap prop_;
+        PropagationStats stats_;
     };
 
 
@@ -563,4 +696,40 @@ namespace gcomm
     // Cross check traces from vector of dummy nodes
     void check_trace(const std::vector<DummyNode*>& nvec);
 
+    /*!
+     * Parameters for simulated cluster benchmark. Defaults are small enough
+     * to run as a part of the unit test suite, the values can be overridden
+     * from environment (GCOMM_SIM_NODES, GCOMM_SIM_MSGS, GCOMM_SIM_LATENCY,
+     * GCOMM_SIM_LOSS, GCOMM_SIM_BANDWIDTH, GCOMM_SIM_SEED) for offline
+     * tuning runs. GCOMM_SIM_EVS_CONF may contain additional EVS options
+     * in URI query format, e.g. "evs.send_window=8&evs.use_aggregate=false".
+     */
+    struct SimParams
+    {
+        SimParams();
+
+        size_t   n_nodes;   // 3 to 64
+        size_t   n_msgs;    // messages sent by each node
+        size_t   latency;   // link latency in ticks
+        double   loss;      // link delivery probability, 1.0 means no loss
+        size_t   bandwidth; // link bandwidth in bytes per tick, 0 unlimited
+        unsigned seed;
+        std::string evs_conf;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const SimParams& p);
+
+    /*!
+     * Join nodes one by one into a cluster over propagation matrix
+     * configured according to params, then send params.n_msgs from each
+     * node and propagate until all messages have been delivered.
+     * Node views are expected to reach view type vt.
+     *
+     * @return metrics collected during the run
+     */
+    PropagationStats sim_benchmark(PropagationMatrix& prop,
+                                   std::vector<DummyNode*>& nvec,
+                                   const SimParams& params,
+                                   ViewType vt);
+
 } // namespace gcomm
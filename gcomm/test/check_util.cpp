@@ -15,6 +15,12 @@
 
 #include "gu_logger.hpp"
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include <vector>
 #include <fstream>
 #include <limits>
@@ -89,6 +95,28 @@ START_TEST(test_datagram)
         fail_unless(dg16.payload()[i + dg16.offset()] == i + 16);
     }
 
+    // Cached checksum must follow header and checksum type changes
+    const gcomm::Datagram& cdg(dg);
+    uint32_t const cs(cdg.checksum(NetHeader::CS_CRC32C));
+    fail_unless(cs == crc32(NetHeader::CS_CRC32C, dg));
+    fail_unless(cdg.checksum(NetHeader::CS_CRC32C) == cs);
+    fail_unless(cdg.checksum(NetHeader::CS_CRC32) ==
+                crc32(NetHeader::CS_CRC32, dg));
+
+    dg.header()[dg.header_offset() - 1] = 0xab;
+    dg.set_header_offset(dg.header_offset() - 1);
+    fail_unless(cdg.checksum(NetHeader::CS_CRC32C) ==
+                crc32(NetHeader::CS_CRC32C, dg));
+    fail_unless(cdg.checksum(NetHeader::CS_CRC32C) != cs);
+
+    dg.set_header_offset(dg.header_offset() + 1);
+    fail_unless(cdg.checksum(NetHeader::CS_CRC32C) == cs);
+
+    dg.payload()[0] = 0xff;
+    fail_unless(cdg.checksum(NetHeader::CS_CRC32C) ==
+                crc32(NetHeader::CS_CRC32C, dg));
+    fail_unless(cdg.checksum(NetHeader::CS_CRC32C) != cs);
+
 #if 0
     // Normalize datagram, all data is moved into payload, data from
     // beginning to offset is discarded. Normalization must not change
@@ -165,6 +193,114 @@ START_TEST(test_asio)
 
 }
 END_TEST
+
+class RecvCounter : public gcomm::Toplay
+{
+public:
+    RecvCounter(gu::Config& conf) : Toplay(conf), n_(0), bytes_(0) { }
+    void handle_up(const void*, const Datagram& dg, const ProtoUpMeta&)
+    {
+        ++n_;
+        bytes_ += dg.len();
+    }
+    size_t n_;
+    size_t bytes_;
+};
+
+static const char* const mcast_group("239.192.0.11");
+
+// whether a datagram sent to mcast_group via loopback comes back
+static bool
+mcast_loopback_available()
+{
+    int const fd(::socket(AF_INET, SOCK_DGRAM, 0));
+    if (fd < 0) return false;
+
+    struct sockaddr_in addr;
+    ::memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = 0;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    struct ip_mreq mreq;
+    mreq.imr_multiaddr.s_addr = inet_addr(mcast_group);
+    mreq.imr_interface.s_addr = inet_addr("127.0.0.1");
+
+    unsigned char const loop(1);
+    socklen_t addr_len(sizeof(addr));
+    bool ret(false);
+
+    if (::bind(fd, reinterpret_cast<struct sockaddr*>(&addr),
+               sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr),
+                      &addr_len) == 0 &&
+        ::setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq,
+                     sizeof(mreq)) == 0 &&
+        ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &mreq.imr_interface,
+                     sizeof(mreq.imr_interface)) == 0 &&
+        ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop,
+                     sizeof(loop)) == 0)
+    {
+        addr.sin_addr = mreq.imr_multiaddr;
+        char c('x');
+        struct pollfd pfd = { fd, POLLIN, 0 };
+
+        ret = (::sendto(fd, &c, 1, 0,
+                        reinterpret_cast<struct sockaddr*>(&addr),
+                        sizeof(addr)) == 1 &&
+               ::poll(&pfd, 1, 1000) == 1);
+    }
+
+    ::close(fd);
+    return ret;
+}
+
+// Multicast socket with loopback enabled receives its own datagrams
+START_TEST(test_asio_udp_mcast)
+{
+    if (!mcast_loopback_available())
+    {
+        log_info << "test_asio_udp_mcast: skipped, no route for loopback "
+                 << "multicast to " << mcast_group;
+        return;
+    }
+
+    gu::Config conf;
+    gu::ssl_register_params(conf);
+    gcomm::Conf::register_params(conf);
+    AsioProtonet pn(conf);
+
+    RecvCounter counter(conf);
+    Protostack pstack;
+    pstack.push_proto(&counter);
+    pn.insert(&pstack);
+
+    string uri_str("udp://" + string(mcast_group) +
+                   ":4568?socket.if_addr=127.0.0.1&socket.if_loop=1");
+    SocketPtr mc = pn.socket(uri_str);
+    mc->connect(uri_str);
+
+    vector<byte_t> buf(1024);
+    size_t const n_msgs(50); // fits into default socket receive buffer
+    for (size_t i = 0; i < n_msgs; ++i)
+    {
+        Datagram dg(Buffer(&buf[0], &buf[0] + buf.size()));
+        fail_unless(mc->send(dg) == 0);
+    }
+
+    for (size_t i(0); i < 10 && counter.n_ < n_msgs; ++i)
+    {
+        pn.event_loop(gu::datetime::Sec/10);
+    }
+
+    fail_unless(counter.n_ == n_msgs, "received %zu", counter.n_);
+    fail_unless(counter.bytes_ == n_msgs*buf.size());
+
+    mc->close();
+    pn.erase(&pstack);
+    pstack.pop_proto(&counter);
+}
+END_TEST
 #endif // HAVE_ASIO_HPP
 
 START_TEST(test_protonet)
@@ -243,6 +379,7 @@ Suite* util_suite()
 #ifdef HAVE_ASIO_HPP
     tc = tcase_create("test_asio");
     tcase_add_test(tc, test_asio);
+    tcase_add_test(tc, test_asio_udp_mcast);
     suite_add_tcase(s, tc);
 #endif // HAVE_ASIO_HPP
 
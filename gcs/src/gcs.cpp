@@ -16,6 +16,8 @@
 #include <assert.h>
 
 #include <galerautils.h>
+#include <gu_event_trace.hpp>
+#include <gu_thread_affinity.hpp>
 
 #include "gcs_priv.hpp"
 #include "gcs_params.hpp"
@@ -25,6 +27,7 @@
 #include "gcs_fifo_lite.hpp"
 #include "gcs_sm.hpp"
 #include "gcs_gcache.hpp"
+#include "gcs_defrag.hpp" // GCS_DEFRAG_HDR_ONLY()
 
 const char* gcs_node_state_to_str (gcs_node_state_t state)
 {
@@ -124,6 +127,8 @@ struct gcs_conn
     /* A queue for threads waiting for replicated actions */
     gcs_fifo_lite_t* repl_q;
     gu_thread_t      send_thread;
+    struct gcs_repl_act* send_repl_act; // action being sent, if replicated
+    struct gcs_repl_act* lent_repl_act; // action that lent the send monitor
 
     /* A queue for threads waiting for received actions */
     gu_fifo_t*   recv_q;
@@ -182,6 +187,31 @@ struct gcs_repl_act
     { }
 };
 
+/*!
+ * Lends send monitor to the next sender in between fragments of a long
+ * action, see gcs_core_set_yield()
+ */
+static bool
+_send_yield (void* const ctx)
+{
+    gcs_conn_t*          const conn     = static_cast<gcs_conn_t*>(ctx);
+    struct gcs_repl_act* const repl_act = conn->send_repl_act;
+
+    /* replicated action stays in repl_q, borrower puts its entry in front
+     * of it, see gcs_replv() */
+    conn->lent_repl_act = repl_act;
+
+    gu_cond_t cond;
+    gu_cond_init (&cond, NULL);
+    bool const ret(gcs_sm_lend (conn->sm, &cond));
+    gu_cond_destroy (&cond);
+
+    conn->lent_repl_act = NULL;
+    conn->send_repl_act = repl_act;
+
+    return ret;
+}
+
 /*! Releases resources associated with parameters */
 static void
 _cleanup_params (gcs_conn_t* conn)
@@ -282,6 +312,12 @@ gcs_create (gu_config_t* const conf, gcache_t* const gcache,
         goto sm_create_failed;
     }
 
+    gcs_sm_set_lane_weight (conn->sm, conn->params.fast_lane_weight);
+
+    conn->send_repl_act = NULL;
+    conn->lent_repl_act = NULL;
+    gcs_core_set_yield (conn->core, _send_yield, conn);
+
     conn->state        = GCS_CONN_CLOSED;
     conn->my_idx       = -1;
     conn->local_act_id = GCS_SEQNO_FIRST;
@@ -1174,6 +1210,8 @@ static void *gcs_recv_thread (void *arg)
     gcs_conn_t* conn = (gcs_conn_t*)arg;
     ssize_t     ret  = -ECONNABORTED;
 
+    gu::ThreadAffinity::apply (gu::ThreadAffinity::GCS_RECV);
+
     // To avoid race between gcs_open() and the following state check in while()
     gu_cond_t tmp_cond; /* TODO: rework when concurrency in SM is allowed */
     gu_cond_init (&tmp_cond, NULL);
@@ -1236,6 +1274,10 @@ static void *gcs_recv_thread (void *arg)
             this_act_id = gu_atomic_fetch_and_add(&conn->local_act_id, 1);
         }
 
+        if (GCS_ACT_TORDERED == rcvd.act.type) {
+            gu::EventTrace::record (gu::EventTrace::GCS_DELIVER, rcvd.id);
+        }
+
         if (NULL != rcvd.local                                          &&
             (repl_act_ptr = (struct gcs_repl_act**)
              gcs_fifo_lite_get_head (conn->repl_q))                     &&
@@ -1480,6 +1522,19 @@ long gcs_destroy (gcs_conn_t *conn)
     return 0;
 }
 
+/* Actions bigger than fast_lane_size and TOI go to the bulk send lane */
+static inline gcs_sm_lane_t
+_send_lane (const gcs_conn_t* conn, size_t act_size, bool bulk)
+{
+    long const fast_lane_size(conn->params.fast_lane_size);
+
+    if (fast_lane_size > 0 && (bulk || act_size > (size_t)fast_lane_size)) {
+        return GCS_SM_BULK;
+    }
+
+    return GCS_SM_FAST;
+}
+
 /* Puts action in the send queue and returns */
 long gcs_sendv (gcs_conn_t*          const conn,
                 const struct gu_buf* const act_bufs,
@@ -1497,8 +1552,11 @@ long gcs_sendv (gcs_conn_t*          const conn,
     gu_cond_t tmp_cond;
     gu_cond_init (&tmp_cond, NULL);
 
-    if (!(ret = gcs_sm_enter (conn->sm, &tmp_cond, scheduled, true)))
+    if (!(ret = gcs_sm_enter (conn->sm, &tmp_cond, scheduled, true,
+                              _send_lane (conn, act_size, false))))
     {
+        conn->send_repl_act = NULL;
+
         while ((GCS_CONN_OPEN >= conn->state) &&
                (ret = gcs_core_send (conn->core, act_bufs,
                                      act_size, act_type)) == -ERESTART);
@@ -1509,9 +1567,9 @@ long gcs_sendv (gcs_conn_t*          const conn,
     return ret;
 }
 
-long gcs_schedule (gcs_conn_t* conn)
+long gcs_schedule (gcs_conn_t* conn, size_t act_size, bool bulk)
 {
-    return gcs_sm_schedule (conn->sm);
+    return gcs_sm_schedule (conn->sm, _send_lane (conn, act_size, bulk));
 }
 
 long gcs_interrupt (gcs_conn_t* conn, long handle)
@@ -1554,7 +1612,8 @@ long gcs_replv (gcs_conn_t*          const conn,      //!<in
         // 1. serializes gcs_core_send() access between gcs_repl() and
         //    gcs_send()
         // 2. avoids race with gcs_close() and gcs_destroy()
-        if (!(ret = gcs_sm_enter (conn->sm, &repl_act.wait_cond, scheduled, true)))
+        if (!(ret = gcs_sm_enter (conn->sm, &repl_act.wait_cond, scheduled,
+                                  true, _send_lane (conn, act->size, false))))
         {
             struct gcs_repl_act** act_ptr;
 
@@ -1574,6 +1633,14 @@ long gcs_replv (gcs_conn_t*          const conn,      //!<in
             {
                 *act_ptr = &repl_act;
                 gcs_fifo_lite_push_tail (conn->repl_q);
+                conn->send_repl_act = &repl_act;
+
+                /* sent while the send monitor is lent: will be received
+                 * before the lender, see _send_yield() */
+                if (conn->lent_repl_act &&
+                    !gcs_fifo_lite_swap_tail (conn->repl_q)) {
+                    assert(0);
+                }
 
                 // Keep on trying until something else comes out
                 while ((ret = gcs_core_send (conn->core, act_in, act->size,
@@ -1585,7 +1652,9 @@ long gcs_replv (gcs_conn_t*          const conn,      //!<in
                              act->buf, act->size,gcs_act_type_to_str(act->type),
                              ret, strerror(-ret));
 
-                    if (!gcs_fifo_lite_remove (conn->repl_q)) {
+                    if ((conn->lent_repl_act &&
+                         !gcs_fifo_lite_swap_tail (conn->repl_q)) ||
+                        !gcs_fifo_lite_remove (conn->repl_q)) {
                         gu_fatal ("Failed to remove unsent item from repl_q");
                         assert(0);
                         ret = -ENOTRECOVERABLE;
@@ -1603,17 +1672,13 @@ long gcs_replv (gcs_conn_t*          const conn,      //!<in
             /* now we can go waiting for action delivery */
             if (ret >= 0) {
                 gu_cond_wait (&repl_act.wait_cond, &repl_act.wait_mutex);
-#ifndef GCS_FOR_GARB
                 /* assert (act->buf != 0); */
-                if (act->buf == 0)
+                if (act->buf == 0 && !GCS_DEFRAG_HDR_ONLY(conn->gcache))
                 {
                     /* Recv thread purged repl_q before action was delivered */
                     ret = -ENOTCONN;
                     goto out;
                 }
-#else
-                assert (act->buf == 0);
-#endif /* GCS_FOR_GARB */
 
                 if (act->seqno_g < 0) {
                     assert (GCS_SEQNO_ILL    == act->seqno_l ||
@@ -1641,9 +1706,7 @@ long gcs_replv (gcs_conn_t*          const conn,      //!<in
                 }
             }
         }
-#ifndef GCS_FOR_GARB
     out:
-#endif /* GCS_FOR_GARB */
         gu_mutex_unlock  (&repl_act.wait_mutex);
     }
     gu_mutex_destroy (&repl_act.wait_mutex);
@@ -1726,12 +1789,8 @@ long gcs_request_state_transfer (gcs_conn_t  *conn,
 
         if (ret > 0) {
             assert (action.buf != rst);
-#ifndef GCS_FOR_GARB
-            assert (action.buf != NULL);
-            gcs_gcache_free (conn->gcache, action.buf);
-#else
-            assert (action.buf == NULL);
-#endif
+            assert ((action.buf == NULL) == GCS_DEFRAG_HDR_ONLY(conn->gcache));
+            if (action.buf) gcs_gcache_free (conn->gcache, action.buf);
             assert (ret == (ssize_t)rst_size);
             assert (action.seqno_g >= 0);
             assert (action.seqno_l >  0);
@@ -1795,6 +1854,10 @@ long gcs_recv (gcs_conn_t*        conn,
         action->seqno_g = recv_act->rcvd.id;
         action->seqno_l = recv_act->local_id;
 
+        if (GCS_ACT_TORDERED == action->type) {
+            gu::EventTrace::record (gu::EventTrace::GCS_RECV, action->seqno_g);
+        }
+
         if (gu_unlikely (GCS_ACT_CONF == action->type)) {
             err = gu_fifo_cancel_gets (conn->recv_q);
             if (err) {
@@ -1950,6 +2013,18 @@ gcs_get_stats (gcs_conn_t* conn, struct gcs_stats* stats)
                       &stats->fc_paused_ns,
                       &stats->fc_paused_avg);
 
+    gcs_sm_lane_stats_get (conn->sm, GCS_SM_FAST,
+                           &stats->send_q_fast_len,
+                           &stats->send_q_fast_len_max,
+                           &stats->send_q_fast_len_min,
+                           &stats->send_q_fast_len_avg);
+
+    gcs_sm_lane_stats_get (conn->sm, GCS_SM_BULK,
+                           &stats->send_q_bulk_len,
+                           &stats->send_q_bulk_len_max,
+                           &stats->send_q_bulk_len_min,
+                           &stats->send_q_bulk_len_avg);
+
     stats->fc_sent     = conn->stats_fc_sent;
     stats->fc_received = conn->stats_fc_received;
 }
@@ -2103,6 +2178,51 @@ _set_pkt_size (gcs_conn_t* conn, const char* value)
     }
 }
 
+static long
+_set_fast_lane_size (gcs_conn_t* conn, const char* value)
+{
+    long long size;
+    const char* const endptr = gu_str2ll (value, &size);
+
+    if (size >= 0 && *endptr == '\0') {
+
+        if (size > LONG_MAX) size = LONG_MAX;
+
+        if (conn->params.fast_lane_size == size) return 0;
+
+        gu_config_set_int64 (conn->config, GCS_PARAMS_FAST_LANE_SIZE, size);
+        conn->params.fast_lane_size = size;
+
+        return 0;
+    }
+    else {
+        return -EINVAL;
+    }
+}
+
+static long
+_set_fast_lane_weight (gcs_conn_t* conn, const char* value)
+{
+    long long weight;
+    const char* const endptr = gu_str2ll (value, &weight);
+
+    if (weight > 0 && *endptr == '\0') {
+
+        if (weight > LONG_MAX) weight = LONG_MAX;
+
+        if (conn->params.fast_lane_weight == weight) return 0;
+
+        gu_config_set_int64 (conn->config, GCS_PARAMS_FAST_LANE_WEIGHT, weight);
+        conn->params.fast_lane_weight = weight;
+        gcs_sm_set_lane_weight (conn->sm, weight);
+
+        return 0;
+    }
+    else {
+        return -EINVAL;
+    }
+}
+
 static long
 _set_recv_q_hard_limit (gcs_conn_t* conn, const char* value)
 {
@@ -2189,6 +2309,12 @@ long gcs_param_set  (gcs_conn_t* conn, const char* key, const char *value)
     else if (!strcmp (key, GCS_PARAMS_MAX_PKT_SIZE)) {
         return _set_pkt_size (conn, value);
     }
+    else if (!strcmp (key, GCS_PARAMS_FAST_LANE_SIZE)) {
+        return _set_fast_lane_size (conn, value);
+    }
+    else if (!strcmp (key, GCS_PARAMS_FAST_LANE_WEIGHT)) {
+        return _set_fast_lane_weight (conn, value);
+    }
     else if (!strcmp (key, GCS_PARAMS_RECV_Q_HARD_LIMIT)) {
         return _set_recv_q_hard_limit (conn, value);
     }
@@ -248,12 +248,16 @@ extern long gcs_recv (gcs_conn_t*        conn,
  * @brief Schedules entry to CGS send monitor.
  * Locks send monitor and should be quickly followed by gcs_repl()/gcs_send()
  *
+ * @param act_size size of the action to be sent
+ * @param bulk     action should be queued in the bulk lane regardless of
+ *                 its size (e.g. TOI), see gcs.fast_lane_size
+ *
  * @retval 0       - won't queue
  * @retval >0      - queue handle
  * @retval -EAGAIN - too many queued threads
  * @retval -EBADFD - connection is closed
  */
-extern long gcs_schedule (gcs_conn_t* conn);
+extern long gcs_schedule (gcs_conn_t* conn, size_t act_size, bool bulk);
 
 /*!
  * @brief Interrupt a thread waiting to enter send monitor.
@@ -440,6 +444,14 @@ struct gcs_stats
     int       send_q_len;     //! current send queue length
     int       send_q_len_max; //! maximum send queue length
     int       send_q_len_min; //! minimum send queue length
+    double    send_q_fast_len_avg; //! same as above for fast lane queue
+    int       send_q_fast_len;
+    int       send_q_fast_len_max;
+    int       send_q_fast_len_min;
+    double    send_q_bulk_len_avg; //! same as above for bulk lane queue
+    int       send_q_bulk_len;
+    int       send_q_bulk_len_max;
+    int       send_q_bulk_len_min;
     gcs_backend_stats_t backend_stats; //! backend stats.
 };
 
@@ -5,9 +5,10 @@
  */
 /*
  * Interface to action protocol
- * (to be extended to support protocol versions, currently supports only v0)
+ * (supports versions 0 and 1)
  */
 #include <errno.h>
+#include <string.h>
 #include "gcs_act_proto.hpp"
 
 /*
@@ -22,6 +23,9 @@ bytes: 00 01                07 08       11 12       15 16       19 20
 PV - protocol version
 AT - action type
 
+  Version 1 header is the same. Senders may interleave fragments of a long
+  action with other actions, receivers keep two defragmenters per sender.
+
 */
 
 static const size_t PROTO_PV_OFFSET       = 0;
@@ -58,7 +62,7 @@ gcs_act_proto_write (gcs_act_frag_t* frag, void* buf, size_t buf_len)
                   frag->act_type, PROTO_AT_MAX);
         return -EOVERFLOW;
     }
-    if (frag->proto_ver != PROTO_VERSION) return -EPROTO;
+    if (frag->proto_ver > PROTO_VERSION) return -EPROTO;
     if (buf_len      < PROTO_DATA_OFFSET) return -EMSGSIZE;
 #endif
 
@@ -98,10 +102,18 @@ gcs_act_proto_read (gcs_act_frag_t* frag, const void* buf, size_t buf_len)
         return -EPROTO; // this fragment should be dropped
     }
 
-    ((uint8_t*)buf)[PROTO_PV_OFFSET] = 0x0;
-    frag->act_id   = gu_be64(*(uint64_t*)buf);
-    frag->act_size = gtohl  (((uint32_t*)buf)[2]);
-    frag->frag_no  = gtohl  (((uint32_t*)buf)[3]);
+    // buffer may be shared, mask out protocol version instead of
+    // clearing it in place
+    // buffer may also be unaligned, read header fields via memcpy()
+    uint64_t act_id;
+    uint32_t act_size, frag_no;
+    memcpy (&act_id,   buf, sizeof(act_id));
+    memcpy (&act_size, (uint8_t*)buf + 8,  sizeof(act_size));
+    memcpy (&frag_no,  (uint8_t*)buf + 12, sizeof(frag_no));
+
+    frag->act_id   = gu_be64(act_id) & 0x00FFFFFFFFFFFFFFULL;
+    frag->act_size = gtohl  (act_size);
+    frag->frag_no  = gtohl  (frag_no);
     frag->act_type = static_cast<gcs_act_type_t>(
         ((uint8_t*)buf)[PROTO_AT_OFFSET]);
     frag->frag     = ((uint8_t*)buf) + PROTO_DATA_OFFSET;
@@ -93,6 +93,10 @@ long fn (gcs_backend_t* const backend,    \
  *        OR
  *        the length of the message, so if it is bigger
  *        than len, it has to be reread with a bigger buffer
+ *
+ * Instead of copying the message backend may set msg->buf to point to
+ * the message in its own storage and msg->buf_len to message length.
+ * Such message must stay valid and unchanged until the next call.
  */
 #define GCS_BACKEND_RECV_FN(fn)                 \
 long fn (gcs_backend_t*  const backend,         \
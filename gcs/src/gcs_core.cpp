@@ -65,9 +65,14 @@ struct gcs_core
     void*           send_buf;
     size_t          send_buf_len;
     gcs_seqno_t     send_act_no;
+    gcs_core_yield_t send_yield;    // lets other actions between fragments
+    void*           send_yield_ctx;
+    bool            send_yielding;  // other actions are being sent
 
     /* recv part */
     gcs_recv_msg_t  recv_msg;
+    void*           recv_buf;     // recv_msg.buf may point to backend data
+    int             recv_buf_len;
 
     /* local action FIFO */
     gcs_fifo_lite_t* fifo;
@@ -101,7 +106,8 @@ typedef struct causal_act
     gu_cond_t*   cond;
 } causal_act_t;
 
-static int const GCS_PROTO_MAX = 0;
+/* 1 - fragments of different actions from the same sender may interleave */
+static int const GCS_PROTO_MAX = 1;
 
 gcs_core_t*
 gcs_core_create (gu_config_t* const conf,
@@ -121,10 +127,10 @@ gcs_core_create (gu_config_t* const conf,
         core->cache  = cache;
 
         // Need to allocate something, otherwise Spread 3.17.3 freaks out.
-        core->recv_msg.buf = gu_malloc(CORE_INIT_BUF_SIZE);
-        if (core->recv_msg.buf) {
+        core->recv_buf = gu_malloc(CORE_INIT_BUF_SIZE);
+        if (core->recv_buf) {
 
-            core->recv_msg.buf_len = CORE_INIT_BUF_SIZE;
+            core->recv_buf_len = CORE_INIT_BUF_SIZE;
 
             core->send_buf = GU_CALLOC(CORE_INIT_BUF_SIZE, char);
             if (core->send_buf) {
@@ -141,6 +147,9 @@ gcs_core_create (gu_config_t* const conf,
                                     appl_proto_ver);
                     core->state = CORE_CLOSED;
                     core->send_act_no = 1; // 0 == no actions sent
+                    core->send_yield     = NULL;
+                    core->send_yield_ctx = NULL;
+                    core->send_yielding  = false;
 #ifdef GCS_CORE_TESTING
                     gu_lock_step_init (&core->ls);
                     core->state_uuid = GU_UUID_NIL;
@@ -151,7 +160,7 @@ gcs_core_create (gu_config_t* const conf,
                 gu_free (core->send_buf);
             }
 
-            gu_free (core->recv_msg.buf);
+            gu_free (core->recv_buf);
         }
 
         gu_free (core);
@@ -299,6 +308,43 @@ core_msg_send_retry (gcs_core_t*    core,
     return ret;
 }
 
+/*!
+ * Lets other actions to be sent in between fragments of a long one.
+ * Own local FIFO entry stays in place, other actions put their entries
+ * in front of it, so that local actions stay in the order of their last
+ * fragments, which is the order they are received in. Other actions reuse
+ * send_buf, so header is rewritten if anything was sent.
+ *
+ * @return 0 or negative error code
+ */
+static long
+core_send_yield (gcs_core_t*     const conn,
+                 gcs_act_frag_t* const frg)
+{
+    /* other actions must have different ids */
+    if (conn->send_act_no == frg->act_id) conn->send_act_no++;
+
+    conn->send_yielding = true;
+    bool const yielded(conn->send_yield (conn->send_yield_ctx));
+    conn->send_yielding = false;
+
+    if (!yielded) {
+        /* nobody took the id, give it back */
+        if (conn->send_act_no == frg->act_id + 1) conn->send_act_no--;
+        return 0;
+    }
+
+    size_t const frag_len = frg->frag_len;
+
+    long const ret(gcs_act_proto_write (frg, conn->send_buf,
+                                        conn->send_buf_len));
+
+    /* don't send more than before, see gcs_core_send() */
+    if (!ret && frag_len < frg->frag_len) frg->frag_len = frag_len;
+
+    return ret;
+}
+
 ssize_t
 gcs_core_send (gcs_core_t*          const conn,
                const struct gu_buf* const action,
@@ -317,6 +363,12 @@ gcs_core_send (gcs_core_t*          const conn,
     assert (action != NULL);
     assert (act_size > 0);
 
+    /* Fragments of service actions can't interleave: there is only one
+     * out-of-band defragmenter per sender, see gcs_node_handle_act_frag() */
+    bool const     yield = (proto_ver >= 1 && NULL != conn->send_yield &&
+                            !conn->send_yielding &&
+                            GCS_ACT_SERVICE != act_type);
+
     /*
      * Action header will be replicated with every message.
      * It may seem like an extra overhead, but it is tiny
@@ -334,8 +386,12 @@ gcs_core_send (gcs_core_t*          const conn,
         return ret;
 
     if ((local_act = (core_act_t*)gcs_fifo_lite_get_tail (conn->fifo))) {
-        *local_act = (core_act_t){ conn->send_act_no, action, act_size };
+        *local_act = (core_act_t){ frg.act_id, action, act_size };
         gcs_fifo_lite_push_tail (conn->fifo);
+
+        /* sent in between fragments of a long action: will be received
+         * before it, see core_send_yield() */
+        if (conn->send_yielding) gcs_fifo_lite_swap_tail (conn->fifo);
     }
     else {
         ret = core_error (conn->state);
@@ -348,6 +404,13 @@ gcs_core_send (gcs_core_t*          const conn,
     size_t         left = action[idx].size;
 
     do {
+        if (yield && frg.frag_no > 0) {
+            if ((ret = core_send_yield (conn, &frg))) {
+                gcs_fifo_lite_remove (conn->fifo);
+                goto out;
+            }
+        }
+
         const size_t chunk_size =
             act_size < frg.frag_len ? act_size : frg.frag_len;
 
@@ -435,7 +498,10 @@ gcs_core_send (gcs_core_t*          const conn,
              *
              * 1. Action will never be received completely by this node. Hence
              *    action must be removed from fifo on behalf of sending thr.: */
+            if (conn->send_yielding) gcs_fifo_lite_swap_tail (conn->fifo);
             gcs_fifo_lite_remove (conn->fifo);
+            /* send_act_no is left as it is: actions sent in between
+             * fragments of this one may have taken higher ids already */
             /* 2. Members will have to discard received fragments.
              * Two reasons could lead us here: new member(s) in configuration
              * change or broken connection (leave group). In both cases other
@@ -443,12 +509,14 @@ gcs_core_send (gcs_core_t*          const conn,
             goto out;
         }
 
-    } while (act_size && gcs_act_proto_inc(conn->send_buf));
+    } while (act_size &&
+             (frg.frag_no = gcs_act_proto_inc(conn->send_buf)));
 
     assert (0 == act_size);
 
-    /* successfully sent action, increment send counter */
-    conn->send_act_no++;
+    /* successfully sent action, increment send counter unless it was
+     * already done in core_send_yield() */
+    if (conn->send_act_no == frg.act_id) conn->send_act_no++;
     ret = sent;
 
 out:
@@ -458,26 +526,34 @@ out:
 
 /* A helper for gcs_core_recv().
  * Deals with fetching complete message from backend
- * and reallocates recv buf if needed */
+ * and reallocates recv buf if needed.
+ * Backend may return the message in place in its own storage instead of
+ * copying it to recv buf, so recv_msg->buf is reset before every call. */
 static inline long
-core_msg_recv (gcs_backend_t* backend, gcs_recv_msg_t* recv_msg,
-               long long timeout)
+core_msg_recv (gcs_core_t* core, long long timeout)
 {
+    gcs_backend_t*  const backend  = &core->backend;
+    gcs_recv_msg_t* const recv_msg = &core->recv_msg;
     long ret;
 
+    recv_msg->buf     = core->recv_buf;
+    recv_msg->buf_len = core->recv_buf_len;
+
     ret = backend->recv (backend, recv_msg, timeout);
 
     while (gu_unlikely(ret > recv_msg->buf_len)) {
         /* recv_buf too small, reallocate */
         /* sometimes - like in case of component message, we may need to
          * do reallocation 2 times. This should be fixed in backend */
-        void* msg = gu_realloc (recv_msg->buf, ret);
+        void* msg = gu_realloc (core->recv_buf, ret);
         gu_debug ("Reallocating buffer from %d to %d bytes",
-                  recv_msg->buf_len, ret);
+                  core->recv_buf_len, ret);
         if (msg) {
             /* try again */
-            recv_msg->buf     = msg;
-            recv_msg->buf_len = ret;
+            core->recv_buf     = msg;
+            core->recv_buf_len = ret;
+            recv_msg->buf      = msg;
+            recv_msg->buf_len  = ret;
 
             ret = backend->recv (backend, recv_msg, timeout);
 
@@ -549,11 +625,7 @@ core_handle_act_msg (gcs_core_t*          core,
 
         if (ret > 0) { /* complete action received */
             assert (act->act.buf_len == ret);
-#ifndef GCS_FOR_GARB
-            assert (NULL != act->act.buf);
-#else
-            assert (NULL == act->act.buf);
-#endif
+            assert (GCS_DEFRAG_HDR_ONLY(core->cache) == (NULL == act->act.buf));
             act->sender_idx = msg->sender_idx;
 
             if (gu_likely(!my_msg)) {
@@ -609,6 +681,7 @@ core_handle_act_msg (gcs_core_t*          core,
                             // act->id != GCS_SEQNO_ILL (most likely act->id == -EAGAIN)
                             core->state == CORE_PRIMARY)) {
 #ifdef GCS_FOR_GARB
+            if (GCS_DEFRAG_HDR_ONLY(core->cache)) {
             /* ignoring state requests from other nodes (not allocated) */
             if (my_msg) {
                 if (act->act.buf_len != act->local[0].size) {
@@ -617,10 +690,8 @@ core_handle_act_msg (gcs_core_t*          core,
                     abort();
                 }
                 act->act.buf = act->local[0].ptr;
-#endif
                 ret = gcs_group_handle_state_request (group, act);
                 assert (ret <= 0 || ret == act->act.buf_len);
-#ifdef GCS_FOR_GARB
                 if (ret < 0) gu_fatal ("Handling state request failed: %d",ret);
                 act->act.buf = NULL;
             }
@@ -631,7 +702,13 @@ core_handle_act_msg (gcs_core_t*          core,
                 act->sender_idx  = -1;
                 ret = 0;
             }
+            }
+            else
 #endif
+            {
+                ret = gcs_group_handle_state_request (group, act);
+                assert (ret <= 0 || ret == act->act.buf_len);
+            }
             }
 //          gu_debug ("Received action: seqno: %lld, sender: %d, size: %d, "
 //                    "act: %p", act->id, msg->sender_idx, ret, act->buf);
@@ -1075,7 +1152,7 @@ ssize_t gcs_core_recv (gcs_core_t*          conn,
         assert (recv_act->id          == GCS_SEQNO_ILL);
         assert (recv_act->sender_idx  == -1);
 
-        ret = core_msg_recv (&conn->backend, recv_msg, timeout);
+        ret = core_msg_recv (conn, timeout);
         if (gu_unlikely (ret <= 0)) {
             goto out; /* backend error while receiving message */
         }
@@ -1211,7 +1288,7 @@ long gcs_core_destroy (gcs_core_t* core)
     gcs_group_free (&core->group);
 
     /* free buffers */
-    gu_free (core->recv_msg.buf);
+    gu_free (core->recv_buf);
     gu_free (core->send_buf);
 
 #ifdef GCS_CORE_TESTING
@@ -1229,6 +1306,13 @@ gcs_core_group_protocol_version (const gcs_core_t* conn)
     return conn->proto_ver;
 }
 
+void
+gcs_core_set_yield (gcs_core_t* core, gcs_core_yield_t yield, void* ctx)
+{
+    core->send_yield_ctx = ctx;
+    core->send_yield     = yield;
+}
+
 long
 gcs_core_set_pkt_size (gcs_core_t* core, long pkt_size)
 {
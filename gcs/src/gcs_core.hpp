@@ -105,6 +105,22 @@ gcs_core_send (gcs_core_t*          core,
                size_t               act_size,
                gcs_act_type_t       act_type);
 
+/*
+ * Callback that gcs_core_send() calls in between fragments of an action to
+ * let other actions to be sent (see gcs_sm_lend()). Must return only after
+ * other senders are done with gcs_core_send().
+ *
+ * @return true if other actions could have been sent
+ */
+typedef bool (*gcs_core_yield_t) (void* ctx);
+
+/*
+ * Sets callback to interleave fragments of different actions. Interleaving
+ * is done only if all group members support it.
+ */
+extern void
+gcs_core_set_yield (gcs_core_t* core, gcs_core_yield_t yield, void* ctx);
+
 /*
  * gcs_core_recv() blocks until some action is received from group.
  *
@@ -69,16 +69,10 @@ gcs_defrag_handle_frag (gcs_defrag_t*         df,
 
                     df->size = frg->act_size;
 
-#ifndef GCS_FOR_GARB
-                    if (df->cache !=NULL) {
-                        gcache_free (df->cache, df->head);
+                    if (!df->hdr_only) {
+                        gcs_gcache_free (df->cache, df->head);
+                        DF_ALLOC();
                     }
-                    else {
-                        free ((void*)df->head);
-                    }
-
-                    DF_ALLOC();
-#endif /* GCS_FOR_GARB */
                 }
             }
             else if (frg->act_id == df->sent_id && frg->frag_no < df->frag_no) {
@@ -109,13 +103,14 @@ gcs_defrag_handle_frag (gcs_defrag_t*         df,
             df->sent_id = frg->act_id;
             df->reset   = false;
 
-#ifndef GCS_FOR_GARB
-            DF_ALLOC();
-#else
-            /* we don't store actions locally at all */
-            df->head = NULL;
-            df->tail = df->head;
-#endif
+            if (gu_likely(!df->hdr_only)) {
+                DF_ALLOC();
+            }
+            else {
+                /* we don't store actions locally at all */
+                df->head = NULL;
+                df->tail = df->head;
+            }
         }
         else {
             /* not a first fragment */
@@ -127,12 +122,12 @@ gcs_defrag_handle_frag (gcs_defrag_t*         df,
                 return 0;
             }
             else {
-                ((char*)frg->frag)[frg->frag_len - 1] = '\0';
                 gu_error ("Unordered fragment received. Protocol error.");
                 gu_error ("Expected: any:0(first), received: %lld:%ld",
                           frg->act_id, frg->frag_no);
-                gu_error ("Contents: '%s', local: %s, reset: %s",
-                          (char*)frg->frag, local ? "yes" : "no",
+                gu_error ("Contents: '%.*s', local: %s, reset: %s",
+                          (int)frg->frag_len, (char*)frg->frag,
+                          local ? "yes" : "no",
                           df->reset ? "yes" : "no");
                 assert(0);
                 return -EPROTO;
@@ -143,21 +138,22 @@ gcs_defrag_handle_frag (gcs_defrag_t*         df,
     df->received += frg->frag_len;
     assert (df->received <= df->size);
 
-#ifndef GCS_FOR_GARB
-    assert (df->tail);
-    memcpy (df->tail, frg->frag, frg->frag_len);
-    df->tail += frg->frag_len;
-#else
-    /* we skip memcpy since have not allocated any buffer */
-    assert (NULL == df->tail);
-    assert (NULL == df->head);
-#endif
+    if (gu_likely(!df->hdr_only)) {
+        assert (df->tail);
+        memcpy (df->tail, frg->frag, frg->frag_len);
+        df->tail += frg->frag_len;
+    }
+    else {
+        /* we skip memcpy since have not allocated any buffer */
+        assert (NULL == df->tail);
+        assert (NULL == df->head);
+    }
 
 #if 1
     if (df->received == df->size) {
         act->buf     = df->head;
         act->buf_len = df->received;
-        gcs_defrag_init (df, df->cache);
+        gcs_defrag_init (df, df->cache, df->hdr_only);
         return act->buf_len;
     }
     else {
@@ -187,7 +183,7 @@ gcs_defrag_handle_frag (gcs_defrag_t*         df,
             assert(local);
             ret = -ERESTART;
         }
-        gcs_defrag_init (df, df->cache); // this also clears df->reset flag
+        gcs_defrag_init (df, df->cache, df->hdr_only); // clears df->reset
         assert(!df->reset);
     }
     else {
@@ -19,6 +19,13 @@
 #include <string.h>   // for memset()
 #include <stdbool.h>
 
+#ifdef GCS_FOR_GARB
+/* arbitrator looks at action payloads only if it stores them in cache */
+#define GCS_DEFRAG_HDR_ONLY(cache) (NULL == (cache))
+#else
+#define GCS_DEFRAG_HDR_ONLY(cache) false
+#endif
+
 typedef struct gcs_defrag
 {
     gcache_t*      cache;
@@ -29,15 +36,22 @@ typedef struct gcs_defrag
     size_t         received;
     ulong          frag_no; // number of fragment received
     bool           reset;
+    bool           hdr_only; // only track fragments, don't store payload
 }
 gcs_defrag_t;
 
+/*!
+ * @param hdr_only if true, fragments are counted and action boundaries
+ *                 detected, but payload is neither allocated nor copied:
+ *                 complete action is returned with NULL buffer.
+ */
 static inline void
-gcs_defrag_init (gcs_defrag_t* df, gcache_t* cache)
+gcs_defrag_init (gcs_defrag_t* df, gcache_t* cache, bool hdr_only = false)
 {
     memset (df, 0, sizeof (*df));
-    df->cache   = cache;
-    df->sent_id = GCS_SEQNO_ILL;
+    df->cache    = cache;
+    df->sent_id  = GCS_SEQNO_ILL;
+    df->hdr_only = hdr_only;
 }
 
 /*!
@@ -57,23 +71,20 @@ gcs_defrag_handle_frag (gcs_defrag_t*         df,
 static inline void
 gcs_defrag_forget (gcs_defrag_t* df)
 {
-    gcs_defrag_init (df, df->cache);
+    gcs_defrag_init (df, df->cache, df->hdr_only);
 }
 
 /*! Free resources associated with defrag (for lost node cleanup) */
 static inline void
 gcs_defrag_free (gcs_defrag_t* df)
 {
-#ifndef GCS_FOR_GARB
     if (df->head) {
+        assert(!df->hdr_only);
         gcs_gcache_free (df->cache, df->head);
         // df->head, df->tail will be zeroed in gcs_defrag_init() below
     }
-#else
-    assert(NULL == df->head);
-#endif
 
-    gcs_defrag_init (df, df->cache);
+    gcs_defrag_init (df, df->cache, df->hdr_only);
 }
 
 /*! Mark current action as reset */
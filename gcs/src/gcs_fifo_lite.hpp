@@ -188,6 +188,36 @@ gcs_fifo_lite_remove (gcs_fifo_lite_t* const fifo)
     return ret;
 }
 
+/*! Swaps two items at the tail, so that the last pushed item precedes
+ *  the one pushed before it. Returns true if success */
+static inline bool
+gcs_fifo_lite_swap_tail (gcs_fifo_lite_t* const fifo)
+{
+    bool ret = false;
+    assert (fifo);
+
+    GCS_FIFO_LITE_LOCK;
+
+    if (fifo->used >= 2) {
+        char* const last = (char*)fifo->queue +
+            ((fifo->tail - 1) & fifo->mask) * fifo->item_size;
+        char* const prev = (char*)fifo->queue +
+            ((fifo->tail - 2) & fifo->mask) * fifo->item_size;
+
+        for (ulong i = 0; i < fifo->item_size; i++) {
+            char const tmp = last[i];
+            last[i] = prev[i];
+            prev[i] = tmp;
+        }
+
+        ret = true;
+    }
+
+    gu_mutex_unlock (&fifo->lock);
+
+    return ret;
+}
+
 static inline bool
 gcs_fifo_lite_not_full (const gcs_fifo_lite_t* const fifo)
 {
@@ -32,6 +32,7 @@
 #include <gu_throw.hpp>
 #include <gu_logger.hpp>
 #include <gu_prodcons.hpp>
+#include <gu_thread_affinity.hpp>
 
 #include <deque>
 
@@ -97,7 +98,8 @@ private:
 
 public:
 
-    RecvBuf() : mutex_(), cond_(), queue_(), waiting_(false) { }
+    RecvBuf() : mutex_(), cond_(), queue_(), waiting_(false),
+                pop_pending_(false) { }
 
     void push_back(const RecvBufData& p)
     {
@@ -112,6 +114,13 @@ public:
     {
         Lock lock(mutex_);
 
+        if (pop_pending_)
+        {
+            assert(queue_.empty() == false);
+            queue_.pop_front();
+            pop_pending_ = false;
+        }
+
         while (queue_.empty())
         {
             Waiting w(waiting_);
@@ -136,12 +145,23 @@ public:
         queue_.pop_front();
     }
 
+    // Front element payload was handed out in place, keep it in the queue
+    // until the next call to front()
+    void pop_front_deferred()
+    {
+        Lock lock(mutex_);
+        assert(queue_.empty() == false);
+        assert(pop_pending_ == false);
+        pop_pending_ = true;
+    }
+
 private:
 
     Mutex mutex_;
     Cond cond_;
     RecvBufQueue queue_;
     bool waiting_;
+    bool pop_pending_;
 };
 
 
@@ -200,6 +220,7 @@ public:
 
     static void* run_fn(void* arg)
     {
+        gu::ThreadAffinity::apply(gu::ThreadAffinity::GCOMM);
         static_cast<GCommConn*>(arg)->run();
         return 0;
     }
@@ -613,8 +634,20 @@ static GCS_BACKEND_RECV_FN(gcomm_recv)
 
             msg->size = pload_len;
 
-            if (gu_likely(pload_len <= msg->buf_len))
+            if (gu_likely(reinterpret_cast<uintptr_t>(b) %
+                          sizeof(uint64_t) == 0))
+            {
+                // Pass the payload in place, it stays valid until the next
+                // call when the datagram is popped from recv_buf.
+                msg->buf     = const_cast<byte_t*>(b);
+                msg->buf_len = pload_len;
+                msg->type    = static_cast<gcs_msg_type_t>(um.user_type());
+                recv_buf.pop_front_deferred();
+            }
+            else if (pload_len <= msg->buf_len)
             {
+                // Message headers are read with aligned loads, copy
+                // misaligned payload to recv buf.
                 memcpy(msg->buf, b, pload_len);
                 msg->type = static_cast<gcs_msg_type_t>(um.user_type());
                 recv_buf.pop_front();
@@ -1473,12 +1473,11 @@ group_get_node_state (const gcs_group_t* const group, long const node_idx)
     if (node->bootstrap)          flags |= GCS_STATE_FBOOTSTRAP;
 #ifdef GCS_FOR_GARB
     flags |= GCS_STATE_ARBITRATOR;
+#endif /* GCS_FOR_GARB */
 
-    int64_t const cached = GCS_SEQNO_ILL;
-#else
-    int64_t const cached = /* group->cache check is needed for unit tests */
+    /* group->cache check is needed for unit tests and cacheless arbitrator */
+    int64_t const cached =
         group->cache ? gcache_seqno_min(group->cache) : GCS_SEQNO_ILL;
-#endif /* GCS_FOR_GARB */
 
     return gcs_state_msg_create (
         &group->state_uuid,
@@ -153,9 +153,12 @@ gcs_group_handle_act_msg (gcs_group_t*          const group,
     assert (frg->act_size > 0);
 
     // clear reset flag if set by own first fragment after reset flag was set
+    // unless own action interleaved with this one is still incomplete
     group->frag_reset = (group->frag_reset &&
                          !(local && 0 == frg->frag_no &&
-                           GCS_GROUP_PRIMARY == group->state));
+                           GCS_GROUP_PRIMARY == group->state &&
+                           !gcs_node_other_act_pending (
+                               &group->nodes[sender_idx], frg)));
 
     ret = gcs_node_handle_act_frag (&group->nodes[sender_idx], frg, &rcvd->act,
                                     local);
@@ -29,8 +29,10 @@ gcs_node_init (gcs_node_t* const node,
     node->status    = GCS_NODE_STATE_NON_PRIM;
     node->name      = strdup (name     ? name     : NODE_NO_NAME);
     node->inc_addr  = strdup (inc_addr ? inc_addr : NODE_NO_ADDR);
-    gcs_defrag_init (&node->app, cache); // GCS_ACT_TORDERED goes only here
-    gcs_defrag_init (&node->oob, NULL);
+    // GCS_ACT_TORDERED goes only to app and app2
+    gcs_defrag_init (&node->app,  cache, GCS_DEFRAG_HDR_ONLY(cache));
+    gcs_defrag_init (&node->app2, cache, GCS_DEFRAG_HDR_ONLY(cache));
+    gcs_defrag_init (&node->oob,  NULL,  GCS_DEFRAG_HDR_ONLY(cache));
 
     node->gcs_proto_ver  = gcs_proto_ver;
     node->repl_proto_ver = repl_proto_ver;
@@ -50,6 +52,7 @@ gcs_node_move (gcs_node_t* dst, gcs_node_t* src)
 
     memcpy (dst, src, sizeof (gcs_node_t));
     gcs_defrag_forget (&src->app);
+    gcs_defrag_forget (&src->app2);
     gcs_defrag_forget (&src->oob);
     src->name      = NULL;
     src->inc_addr  = NULL;
@@ -61,6 +64,7 @@ void
 gcs_node_reset_local (gcs_node_t* node)
 {
     gcs_defrag_reset (&node->app);
+    gcs_defrag_reset (&node->app2);
     gcs_defrag_reset (&node->oob);
 }
 
@@ -68,6 +72,7 @@ gcs_node_reset_local (gcs_node_t* node)
 void
 gcs_node_reset (gcs_node_t* node) {
     gcs_defrag_free (&node->app);
+    gcs_defrag_free (&node->app2);
     gcs_defrag_free (&node->oob);
     gcs_node_reset_local (node);
 }
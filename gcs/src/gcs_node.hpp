@@ -25,6 +25,7 @@
 struct gcs_node
 {
     gcs_defrag_t     app;        // defragmenter for application actions
+    gcs_defrag_t     app2;       // for actions interleaved with app one
     gcs_defrag_t     oob;        // defragmenter for out-of-band service acts.
 
     // globally unique id from a component message
@@ -82,6 +83,36 @@ gcs_node_reset_local (gcs_node_t* node);
  *
  * @return
  */
+/*!
+ * Returns defragmenter for application action fragment. Since protocol v1
+ * fragments of a long action may be interleaved with another action.
+ */
+static inline gcs_defrag_t*
+gcs_node_app_defrag (gcs_node_t* node, const gcs_act_frag_t* frg)
+{
+    if (gu_unlikely(frg->act_id == node->app2.sent_id ||
+                    (node->app.received && frg->act_id != node->app.sent_id))){
+        return &node->app2;
+    }
+
+    return &node->app;
+}
+
+/*!
+ * Returns true if some other application action of the node than the one
+ * the fragment belongs to is partially received.
+ */
+static inline bool
+gcs_node_other_act_pending (gcs_node_t* node, const gcs_act_frag_t* frg)
+{
+    if (GCS_ACT_SERVICE == frg->act_type) {
+        return (node->app.received || node->app2.received);
+    }
+
+    return (&node->app == gcs_node_app_defrag (node, frg) ?
+            node->app2.received : node->app.received);
+}
+
 static inline ssize_t
 gcs_node_handle_act_frag (gcs_node_t*           node,
                           const gcs_act_frag_t* frg,
@@ -89,7 +120,8 @@ gcs_node_handle_act_frag (gcs_node_t*           node,
                           bool                  local)
 {
     if (gu_likely(GCS_ACT_SERVICE != frg->act_type)) {
-        return gcs_defrag_handle_frag (&node->app, frg, act, local);
+        return gcs_defrag_handle_frag (gcs_node_app_defrag (node, frg), frg,
+                                       act, local);
     }
     else if (GCS_ACT_SERVICE == frg->act_type) {
         return gcs_defrag_handle_frag (&node->oob, frg, act, local);
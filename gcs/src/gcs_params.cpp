@@ -19,6 +19,8 @@ const char* const GCS_PARAMS_MAX_PKT_SIZE      = "gcs.max_packet_size";
 const char* const GCS_PARAMS_RECV_Q_HARD_LIMIT = "gcs.recv_q_hard_limit";
 const char* const GCS_PARAMS_RECV_Q_SOFT_LIMIT = "gcs.recv_q_soft_limit";
 const char* const GCS_PARAMS_MAX_THROTTLE      = "gcs.max_throttle";
+const char* const GCS_PARAMS_FAST_LANE_SIZE    = "gcs.fast_lane_size";
+const char* const GCS_PARAMS_FAST_LANE_WEIGHT  = "gcs.fast_lane_weight";
 
 static const char* const GCS_PARAMS_FC_FACTOR_DEFAULT         = "1.0";
 static const char* const GCS_PARAMS_FC_LIMIT_DEFAULT          = "16";
@@ -29,6 +31,8 @@ static const char* const GCS_PARAMS_MAX_PKT_SIZE_DEFAULT      = "64500";
 static ssize_t const GCS_PARAMS_RECV_Q_HARD_LIMIT_DEFAULT     = SSIZE_MAX;
 static const char* const GCS_PARAMS_RECV_Q_SOFT_LIMIT_DEFAULT = "0.25";
 static const char* const GCS_PARAMS_MAX_THROTTLE_DEFAULT      = "0.25";
+static const char* const GCS_PARAMS_FAST_LANE_SIZE_DEFAULT    = "0";
+static const char* const GCS_PARAMS_FAST_LANE_WEIGHT_DEFAULT  = "4";
 
 bool
 gcs_params_register(gu_config_t* conf)
@@ -57,6 +61,10 @@ gcs_params_register(gu_config_t* conf)
                           GCS_PARAMS_RECV_Q_SOFT_LIMIT_DEFAULT);
     ret |= gu_config_add (conf, GCS_PARAMS_MAX_THROTTLE,
                           GCS_PARAMS_MAX_THROTTLE_DEFAULT);
+    ret |= gu_config_add (conf, GCS_PARAMS_FAST_LANE_SIZE,
+                          GCS_PARAMS_FAST_LANE_SIZE_DEFAULT);
+    ret |= gu_config_add (conf, GCS_PARAMS_FAST_LANE_WEIGHT,
+                          GCS_PARAMS_FAST_LANE_WEIGHT_DEFAULT);
 
     return ret;
 }
@@ -186,6 +194,13 @@ gcs_params_init (struct gcs_params* params, gu_config_t* config)
     if ((ret = params_init_long (config, GCS_PARAMS_MAX_PKT_SIZE, 0,LONG_MAX,
                                  &params->max_packet_size))) return ret;
 
+    if ((ret = params_init_long (config, GCS_PARAMS_FAST_LANE_SIZE, 0,LONG_MAX,
+                                 &params->fast_lane_size))) return ret;
+
+    if ((ret = params_init_long (config, GCS_PARAMS_FAST_LANE_WEIGHT,
+                                 1, LONG_MAX,
+                                 &params->fast_lane_weight))) return ret;
+
     if ((ret = params_init_double (config, GCS_PARAMS_FC_FACTOR, 0.0, 1.0,
                                    &params->fc_resume_factor))) return ret;
 
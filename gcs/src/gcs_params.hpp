@@ -16,6 +16,8 @@ struct gcs_params
     ssize_t recv_q_hard_limit;
     long    fc_base_limit;
     long    max_packet_size;
+    long    fast_lane_size;
+    long    fast_lane_weight;
     long    fc_debug;
     bool    fc_master_slave;
     bool    sync_donor;
@@ -30,6 +32,8 @@ extern const char* const GCS_PARAMS_MAX_PKT_SIZE;
 extern const char* const GCS_PARAMS_RECV_Q_HARD_LIMIT;
 extern const char* const GCS_PARAMS_RECV_Q_SOFT_LIMIT;
 extern const char* const GCS_PARAMS_MAX_THROTTLE;
+extern const char* const GCS_PARAMS_FAST_LANE_SIZE;
+extern const char* const GCS_PARAMS_FAST_LANE_WEIGHT;
 
 /*! Register configuration parameters */
 extern bool
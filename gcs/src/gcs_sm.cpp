@@ -25,6 +25,16 @@ sm_init_stats (gcs_sm_stats_t* stats)
     stats->send_q_len_min = 0;
 }
 
+static void
+sm_init_lane_stats (gcs_sm_lane_stats_t* stats)
+{
+    stats->send_q_samples = 0;
+    stats->send_q_len     = 0;
+    stats->users          = 0;
+    stats->users_min      = 0;
+    stats->users_max      = 0;
+}
+
 gcs_sm_t*
 gcs_sm_create (long len, long n)
 {
@@ -39,12 +49,17 @@ gcs_sm_create (long len, long n)
     }
 
     size_t sm_size = sizeof(gcs_sm_t) +
-        len * sizeof(((gcs_sm_t*)(0))->wait_q[0]);
+        GCS_SM_LANES * len * sizeof(((gcs_sm_t*)(0))->wait_q[0]);
 
     gcs_sm_t* sm = static_cast<gcs_sm_t*>(gu_malloc(sm_size));
 
     if (sm) {
         sm_init_stats (&sm->stats);
+        for (int i = 0; i < GCS_SM_LANES; ++i) {
+            sm_init_lane_stats (&sm->lane[i]);
+            sm->wait_q_head[i] = 1;
+            sm->wait_q_tail[i] = 0;
+        }
         gu_mutex_init (&sm->lock, NULL);
 #ifdef GCS_SM_GRAB_RELEASE
         gu_cond_init  (&sm->cond, NULL);
@@ -52,8 +67,6 @@ gcs_sm_create (long len, long n)
 #endif /* GCS_SM_GRAB_RELEASE */
         sm->wait_q_len  = len;
         sm->wait_q_mask = sm->wait_q_len - 1;
-        sm->wait_q_head = 1;
-        sm->wait_q_tail = 0;
         sm->users       = 0;
         sm->users_max   = 0;
         sm->users_min   = 0;
@@ -64,7 +77,16 @@ gcs_sm_create (long len, long n)
 #endif /* GCS_SM_CONCURRENCY */
         sm->pause       = false;
         sm->wait_time   = gu::datetime::Sec;
-        memset (sm->wait_q, 0, sm->wait_q_len * sizeof(sm->wait_q[0]));
+        sm->lend_cond   = NULL;
+        sm->lend_user   = 0;
+        sm->lane_weight = 1;
+        sm->lane_credit = 0;
+        sm->sched_lane  = GCS_SM_FAST;
+        sm->woken_lane  = GCS_SM_FAST;
+        sm->entered_lane = GCS_SM_FAST;
+        sm->lend_lane   = GCS_SM_FAST;
+        memset (sm->wait_q, 0,
+                GCS_SM_LANES * sm->wait_q_len * sizeof(sm->wait_q[0]));
     }
 
     return sm;
@@ -85,7 +107,7 @@ gcs_sm_close (gcs_sm_t* sm)
     gu_cond_init (&cond, NULL);
 
     // in case the queue is full
-    while (sm->users >= (long)sm->wait_q_len) {
+    while (sm->lane[GCS_SM_FAST].users >= (long)sm->wait_q_len) {
         gu_mutex_unlock (&sm->lock);
         usleep(1000);
         gu_mutex_lock (&sm->lock);
@@ -93,10 +115,13 @@ gcs_sm_close (gcs_sm_t* sm)
 
     while (sm->users > 0) { // wait for cleared queue
         sm->users++;
-        GCS_SM_INCREMENT(sm->wait_q_tail);
-        _gcs_sm_enqueue_common (sm, &cond, true);
+        sm->lane[GCS_SM_FAST].users++;
+        GCS_SM_INCREMENT(sm->wait_q_tail[GCS_SM_FAST]);
+        _gcs_sm_enqueue_common (sm, &cond, true, GCS_SM_FAST);
         sm->users--;
-        GCS_SM_INCREMENT(sm->wait_q_head);
+        sm->lane[GCS_SM_FAST].users--;
+        GCS_SM_INCREMENT(sm->wait_q_head[GCS_SM_FAST]);
+        _gcs_sm_wake_up_next (sm); // bulk lane may still have waiters
     }
 
     gu_cond_destroy (&cond);
@@ -185,6 +210,49 @@ gcs_sm_stats_get (gcs_sm_t*  sm,
     }
 }
 
+void
+gcs_sm_lane_stats_get (gcs_sm_t*     sm,
+                       gcs_sm_lane_t lane,
+                       int*          q_len,
+                       int*          q_len_max,
+                       int*          q_len_min,
+                       double*       q_len_avg)
+{
+    if (gu_unlikely(gu_mutex_lock (&sm->lock))) abort();
+
+    gcs_sm_lane_stats_t const tmp(sm->lane[lane]);
+
+    gu_mutex_unlock (&sm->lock);
+
+    *q_len     = tmp.users;
+    *q_len_max = tmp.users_max;
+    *q_len_min = tmp.users_min;
+
+    if (gu_likely(tmp.send_q_len >= 0 && tmp.send_q_samples >= 0)){
+        if (gu_likely(tmp.send_q_samples > 0)) {
+            *q_len_avg = ((double)tmp.send_q_len) / tmp.send_q_samples;
+        }
+        else {
+            *q_len_avg = 0.0;
+        }
+    }
+    else {
+        *q_len_avg = -1.0;
+    }
+}
+
+void
+gcs_sm_set_lane_weight (gcs_sm_t* sm, long weight)
+{
+    assert (weight > 0);
+
+    if (gu_unlikely(gu_mutex_lock (&sm->lock))) abort();
+
+    sm->lane_weight = weight;
+
+    gu_mutex_unlock (&sm->lock);
+}
+
 void
 gcs_sm_stats_flush(gcs_sm_t* sm)
 {
@@ -208,6 +276,14 @@ gcs_sm_stats_flush(gcs_sm_t* sm)
 
     sm->users_max = sm->users;
     sm->users_min = sm->users;
+
+    for (int i = 0; i < GCS_SM_LANES; ++i) {
+        sm->lane[i].send_q_len     = 0;
+        sm->lane[i].send_q_samples = 0;
+        sm->lane[i].users_max      = sm->lane[i].users;
+        sm->lane[i].users_min      = sm->lane[i].users;
+    }
+
     gu_mutex_unlock (&sm->lock);
 }
 
@@ -6,6 +6,12 @@
 
 /*!
  * @file GCS Send Monitor. To ensure fair (FIFO) access to gcs_core_send()
+ *
+ * Users are queued in one of two lanes, each lane being a FIFO. Fast lane is
+ * for small actions, bulk lane - for big actions and TOI. When both lanes
+ * have waiters, the bulk lane gets one entry per lane_weight fast lane
+ * entries. This affects only the order of sending, total order is still
+ * assigned by the group.
  */
 
 #ifndef _gcs_sm_h_
@@ -21,6 +27,14 @@
 #define GCS_SM_CC 1
 #endif /* GCS_SM_CONCURRENCY */
 
+typedef enum gcs_sm_lane
+{
+    GCS_SM_FAST = 0,
+    GCS_SM_BULK,
+    GCS_SM_LANES
+}
+gcs_sm_lane_t;
+
 typedef struct gcs_sm_user
 {
     gu_cond_t* cond;
@@ -28,6 +42,16 @@ typedef struct gcs_sm_user
 }
 gcs_sm_user_t;
 
+typedef struct gcs_sm_lane_stats
+{
+    long long send_q_samples;
+    long long send_q_len;
+    long      users;
+    long      users_min;
+    long      users_max;
+}
+gcs_sm_lane_stats_t;
+
 typedef struct gcs_sm_stats
 {
     long long sample_start;// beginning of the sample period
@@ -44,16 +68,17 @@ gcs_sm_stats_t;
 typedef struct gcs_sm
 {
     gcs_sm_stats_t stats;
+    gcs_sm_lane_stats_t lane[GCS_SM_LANES];
     gu_mutex_t    lock;
 #ifdef GCS_SM_GRAB_RELEASE
     gu_cond_t     cond;
     long          cond_wait;
 #endif /* GCS_SM_GRAB_RELEASE */
-    unsigned long wait_q_len;
+    unsigned long wait_q_len;  // per lane
     unsigned long wait_q_mask;
-    unsigned long wait_q_head;
-    unsigned long wait_q_tail;
-    long          users;
+    unsigned long wait_q_head[GCS_SM_LANES];
+    unsigned long wait_q_tail[GCS_SM_LANES];
+    long          users;       // in all lanes
     long          users_min;
     long          users_max;
     long          entered;
@@ -63,7 +88,15 @@ typedef struct gcs_sm
 #endif /* GCS_SM_CONCURRENCY */
     bool          pause;
     gu::datetime::Period wait_time;
-    gcs_sm_user_t wait_q[];
+    gu_cond_t*    lend_cond; // set while monitor is lent, see gcs_sm_lend()
+    unsigned long lend_user; // wait_q index of the borrower
+    long          lane_weight; // fast lane entries per bulk lane entry
+    long          lane_credit; // fast lane entries since bulk lane entry
+    gcs_sm_lane_t sched_lane;  // lane of gcs_sm_schedule() with lock held
+    gcs_sm_lane_t woken_lane;  // lane of the last woken up waiter
+    gcs_sm_lane_t entered_lane;
+    gcs_sm_lane_t lend_lane;
+    gcs_sm_user_t wait_q[];    // GCS_SM_LANES consecutive rings
 }
 gcs_sm_t;
 
@@ -97,6 +130,46 @@ gcs_sm_destroy (gcs_sm_t* sm);
 
 #define GCS_SM_INCREMENT(cursor) (cursor = ((cursor + 1) & sm->wait_q_mask))
 
+/* index of the lane ring cursor in the wait_q */
+#define GCS_SM_USER(lane, cursor) ((lane) * sm->wait_q_len + (cursor))
+
+static inline void
+_gcs_sm_lane_users_dec (gcs_sm_t* sm, gcs_sm_lane_t lane)
+{
+    sm->users--;
+    if (gu_unlikely(sm->users < sm->users_min)) {
+        sm->users_min = sm->users;
+    }
+
+    sm->lane[lane].users--;
+    if (gu_unlikely(sm->lane[lane].users < sm->lane[lane].users_min)) {
+        sm->lane[lane].users_min = sm->lane[lane].users;
+    }
+}
+
+/* Which lane to take the next waiter from, given which lanes have one */
+static inline gcs_sm_lane_t
+_gcs_sm_next_lane (const gcs_sm_t* sm, bool fast, bool bulk)
+{
+    if (fast && (!bulk || sm->lane_credit < sm->lane_weight)) {
+        return GCS_SM_FAST;
+    }
+
+    return bulk ? GCS_SM_BULK : GCS_SM_FAST;
+}
+
+/* Accounts for the waiter from the lane being let in */
+static inline void
+_gcs_sm_lane_charge (gcs_sm_t* sm, gcs_sm_lane_t lane)
+{
+    if (GCS_SM_FAST == lane) {
+        if (sm->lane[GCS_SM_BULK].users > 0) sm->lane_credit++;
+    }
+    else {
+        sm->lane_credit = 0;
+    }
+}
+
 static inline void
 _gcs_sm_wake_up_next (gcs_sm_t* sm)
 {
@@ -106,20 +179,24 @@ _gcs_sm_wake_up_next (gcs_sm_t* sm)
     assert (woken <= GCS_SM_CC);
 
     while (woken < GCS_SM_CC && sm->users > 0) {
-        if (gu_likely(sm->wait_q[sm->wait_q_head].wait)) {
-            assert (NULL != sm->wait_q[sm->wait_q_head].cond);
-            // gu_debug ("Waking up: %lu", sm->wait_q_head);
-            gu_cond_signal (sm->wait_q[sm->wait_q_head].cond);
+        gcs_sm_lane_t const lane(
+            _gcs_sm_next_lane(sm, sm->lane[GCS_SM_FAST].users > 0,
+                                  sm->lane[GCS_SM_BULK].users > 0));
+        unsigned long const head = GCS_SM_USER(lane, sm->wait_q_head[lane]);
+
+        if (gu_likely(sm->wait_q[head].wait)) {
+            assert (NULL != sm->wait_q[head].cond);
+            // gu_debug ("Waking up: %lu", head);
+            gu_cond_signal (sm->wait_q[head].cond);
+            sm->woken_lane = lane;
+            _gcs_sm_lane_charge (sm, lane);
             woken++;
         }
         else { /* skip interrupted */
-            assert (NULL == sm->wait_q[sm->wait_q_head].cond);
-            gu_debug ("Skipping interrupted: %lu", sm->wait_q_head);
-            sm->users--;
-            if (gu_unlikely(sm->users < sm->users_min)) {
-                sm->users_min = sm->users;
-            }
-            GCS_SM_INCREMENT(sm->wait_q_head);
+            assert (NULL == sm->wait_q[head].cond);
+            gu_debug ("Skipping interrupted: %lu", head);
+            _gcs_sm_lane_users_dec (sm, lane);
+            GCS_SM_INCREMENT(sm->wait_q_head[lane]);
         }
     }
 
@@ -147,26 +224,32 @@ _gcs_sm_wake_up_waiters (gcs_sm_t* sm)
 }
 
 static inline void
-_gcs_sm_leave_common (gcs_sm_t* sm)
+_gcs_sm_leave_common (gcs_sm_t* sm, gcs_sm_lane_t lane)
 {
-    assert (sm->entered < GCS_SM_CC);
+    assert (sm->entered < GCS_SM_CC || sm->lend_cond);
 
     assert (sm->users > 0);
-    sm->users--;
-    if (gu_unlikely(sm->users < sm->users_min)) {
-        sm->users_min = sm->users;
+    assert (sm->lane[lane].users > 0);
+    _gcs_sm_lane_users_dec (sm, lane);
+    assert (false == sm->wait_q[GCS_SM_USER(lane,sm->wait_q_head[lane])].wait);
+    assert (NULL  == sm->wait_q[GCS_SM_USER(lane,sm->wait_q_head[lane])].cond);
+    GCS_SM_INCREMENT(sm->wait_q_head[lane]);
+
+    if (gu_unlikely(NULL != sm->lend_cond)) {
+        /* borrower leaves, give the monitor back to the lender */
+        gu_cond_signal (sm->lend_cond);
+        sm->lend_cond = NULL;
+    }
+    else {
+        _gcs_sm_wake_up_waiters (sm);
     }
-    assert (false == sm->wait_q[sm->wait_q_head].wait);
-    assert (NULL  == sm->wait_q[sm->wait_q_head].cond);
-    GCS_SM_INCREMENT(sm->wait_q_head);
-
-    _gcs_sm_wake_up_waiters (sm);
 }
 
 static inline bool
-_gcs_sm_enqueue_common (gcs_sm_t* sm, gu_cond_t* cond, bool block)
+_gcs_sm_enqueue_common (gcs_sm_t* sm, gu_cond_t* cond, bool block,
+                        gcs_sm_lane_t lane)
 {
-    unsigned long tail = sm->wait_q_tail;
+    unsigned long const tail = GCS_SM_USER(lane, sm->wait_q_tail[lane]);
 
     sm->wait_q[tail].cond = cond;
     sm->wait_q[tail].wait = true;
@@ -174,7 +257,8 @@ _gcs_sm_enqueue_common (gcs_sm_t* sm, gu_cond_t* cond, bool block)
     if (block == true)
     {
         gu_cond_wait (cond, &sm->lock);
-        assert(tail == sm->wait_q_head || false == sm->wait_q[tail].wait);
+        assert(tail == GCS_SM_USER(lane, sm->wait_q_head[lane]) ||
+               false == sm->wait_q[tail].wait || NULL != sm->lend_cond);
         assert(sm->wait_q[tail].cond == cond || false == sm->wait_q[tail].wait);
         sm->wait_q[tail].cond = NULL;
         ret = sm->wait_q[tail].wait;
@@ -220,6 +304,14 @@ _gcs_sm_enqueue_common (gcs_sm_t* sm, gu_cond_t* cond, bool block)
         }
         sm->wait_q[tail].wait = false;
     }
+
+    if (gu_unlikely(!ret && NULL != sm->lend_cond && tail == sm->lend_user)) {
+        /* borrower was interrupted, give the monitor back to the lender,
+         * the slot will be skipped as interrupted later */
+        gu_cond_signal (sm->lend_cond);
+        sm->lend_cond = NULL;
+    }
+
     return ret;
 }
 
@@ -234,38 +326,49 @@ _gcs_sm_enqueue_common (gcs_sm_t* sm, gu_cond_t* cond, bool block)
  * Synchronize with entry order to the monitor. Must be always followed by
  * gcs_sm_enter(sm, cond, true)
  *
+ * @param lane lane to queue in
+ *
  * @retval -EAGAIN - out of space
  * @retval -EBADFD - monitor closed
  * @retval >= 0 queue handle
  */
 static inline long
-gcs_sm_schedule (gcs_sm_t* sm)
+gcs_sm_schedule (gcs_sm_t* sm, gcs_sm_lane_t lane = GCS_SM_FAST)
 {
     if (gu_unlikely(gu_mutex_lock (&sm->lock))) abort();
 
     long ret = sm->ret;
+    gcs_sm_lane_stats_t& ls(sm->lane[lane]);
 
-    if (gu_likely((sm->users < (long)sm->wait_q_len) && (0 == ret))) {
+    if (gu_likely((ls.users < (long)sm->wait_q_len) && (0 == ret))) {
 
         sm->users++;
         if (gu_unlikely(sm->users > sm->users_max)) {
             sm->users_max = sm->users;
         }
-        GCS_SM_INCREMENT(sm->wait_q_tail); /* even if we don't queue, cursor
-                                            * needs to be advanced */
+        ls.users++;
+        if (gu_unlikely(ls.users > ls.users_max)) {
+            ls.users_max = ls.users;
+        }
+        GCS_SM_INCREMENT(sm->wait_q_tail[lane]); /* even if we don't queue,
+                                                  * cursor needs to be
+                                                  * advanced */
+        sm->sched_lane = lane;
         sm->stats.send_q_samples++;
+        ls.send_q_samples++;
 
         if (GCS_SM_HAS_TO_WAIT) {
-            ret = sm->wait_q_tail + 1; // waiter handle
+            ret = GCS_SM_USER(lane, sm->wait_q_tail[lane]) + 1; // waiter handle
 
             /* here we want to distinguish between FC pause and real queue */
             sm->stats.send_q_len += sm->users - 1;
+            ls.send_q_len += ls.users - 1;
         }
 
         return ret; // success
     }
     else if (0 == ret) {
-        assert (sm->users == (long)sm->wait_q_len);
+        assert (ls.users == (long)sm->wait_q_len);
         ret = -EAGAIN;
     }
 
@@ -283,6 +386,7 @@ gcs_sm_schedule (gcs_sm_t* sm)
  * @param cond condition to signal to wake up thread in case of wait
  * @param block if true block until entered or send monitor is closed,
  *              if false enter wait times out eventually
+ * @param lane lane to queue in if not scheduled
  *
  * @retval -EAGAIN - out of space
  * @retval -EBADFD - monitor closed
@@ -290,14 +394,17 @@ gcs_sm_schedule (gcs_sm_t* sm)
  * @retval 0 - successfully entered
  */
 static inline long
-gcs_sm_enter (gcs_sm_t* sm, gu_cond_t* cond, bool scheduled, bool block)
+gcs_sm_enter (gcs_sm_t* sm, gu_cond_t* cond, bool scheduled, bool block,
+              gcs_sm_lane_t lane = GCS_SM_FAST)
 {
     long ret = 0; /* if scheduled and no queue */
 
-    if (gu_likely (scheduled || (ret = gcs_sm_schedule(sm)) >= 0)) {
+    if (gu_likely (scheduled || (ret = gcs_sm_schedule(sm, lane)) >= 0)) {
+
+        lane = sm->sched_lane;
 
         if (GCS_SM_HAS_TO_WAIT) {
-            if (gu_likely(_gcs_sm_enqueue_common (sm, cond, block))) {
+            if (gu_likely(_gcs_sm_enqueue_common (sm, cond, block, lane))) {
                 ret = sm->ret;
             }
             else {
@@ -309,8 +416,13 @@ gcs_sm_enter (gcs_sm_t* sm, gu_cond_t* cond, bool scheduled, bool block)
 
         if (gu_likely(0 == ret)) {
             assert(sm->users   > 0);
-            assert(sm->entered < GCS_SM_CC);
-            sm->entered++;
+            if (gu_likely(NULL == sm->lend_cond)) {
+                assert(sm->entered < GCS_SM_CC);
+                sm->entered++;
+                sm->entered_lane = lane;
+            }
+            /* else borrower uses the entry of the lender */
+            else assert(sm->lend_lane == lane);
         }
         else {
             if (gu_likely(-EINTR == ret)) {
@@ -319,7 +431,7 @@ gcs_sm_enter (gcs_sm_t* sm, gu_cond_t* cond, bool scheduled, bool block)
             else {
                 /* monitor is closed, wake up others */
                 assert(sm->users > 0);
-                _gcs_sm_leave_common(sm);
+                _gcs_sm_leave_common(sm, lane);
             }
         }
 
@@ -334,12 +446,70 @@ gcs_sm_leave (gcs_sm_t* sm)
 {
     if (gu_unlikely(gu_mutex_lock (&sm->lock))) abort();
 
-    sm->entered--;
-    assert(sm->entered >= 0);
+    if (gu_likely(NULL == sm->lend_cond)) {
+        sm->entered--;
+        assert(sm->entered >= 0);
+        _gcs_sm_leave_common(sm, sm->entered_lane);
+    }
+    else {
+        /* borrower leaves, entry stays with the lender */
+        _gcs_sm_leave_common(sm, sm->lend_lane);
+    }
 
-    _gcs_sm_leave_common(sm);
+    gu_mutex_unlock (&sm->lock);
+}
+
+/*!
+ * Lends the monitor to the next waiter without leaving it. This lets
+ * the next waiter to send in between fragments of a long action.
+ * Returns when the borrower leaves the monitor.
+ * Monitor is not lent if nobody is waiting, it is paused or closed, or
+ * is already lent.
+ *
+ * @param cond condition to wait on while the monitor is lent
+ * @return true if the monitor was lent
+ */
+static inline bool
+gcs_sm_lend (gcs_sm_t* sm, gu_cond_t* cond)
+{
+    bool ret = false;
+
+    if (gu_unlikely(gu_mutex_lock (&sm->lock))) abort();
+
+    if (sm->users > 1 && !sm->pause && 0 == sm->ret && NULL == sm->lend_cond) {
+
+        assert (sm->entered > 0);
+
+        /* lender occupies the head of its lane */
+        gcs_sm_lane_t const own(sm->entered_lane);
+        gcs_sm_lane_t const lane(
+            _gcs_sm_next_lane(sm,
+                sm->lane[GCS_SM_FAST].users > (GCS_SM_FAST == own),
+                sm->lane[GCS_SM_BULK].users > (GCS_SM_BULK == own)));
+        unsigned long next = sm->wait_q_head[lane];
+
+        if (lane == own) GCS_SM_INCREMENT(next);
+
+        next = GCS_SM_USER(lane, next);
+
+        if (sm->wait_q[next].wait) {
+            assert (NULL != sm->wait_q[next].cond);
+
+            sm->lend_cond = cond;
+            sm->lend_user = next;
+            sm->lend_lane = lane;
+            _gcs_sm_lane_charge (sm, lane);
+            gu_cond_signal (sm->wait_q[next].cond);
+
+            do { gu_cond_wait (cond, &sm->lock); } while (sm->lend_cond==cond);
+
+            ret = true;
+        }
+    }
 
     gu_mutex_unlock (&sm->lock);
+
+    return ret;
 }
 
 static inline void
@@ -405,7 +575,10 @@ gcs_sm_interrupt (gcs_sm_t* sm, long handle)
         gu_cond_signal (sm->wait_q[handle].cond);
         sm->wait_q[handle].cond = NULL;
         ret = 0;
-        if (!sm->pause && handle == (long)sm->wait_q_head) {
+        gcs_sm_lane_t const lane(
+            static_cast<gcs_sm_lane_t>(handle / sm->wait_q_len));
+        if (!sm->pause && lane == sm->woken_lane &&
+            handle == (long)GCS_SM_USER(lane, sm->wait_q_head[lane])) {
             /* gcs_sm_interrupt() was called right after the waiter was
              * signaled by gcs_sm_continue() or gcs_sm_leave() but before
              * the waiter has woken up. Wake up the next waiter */
@@ -442,6 +615,19 @@ gcs_sm_stats_get (gcs_sm_t*  sm,
                   long long* paused_ns,
                   double*    paused_avg);
 
+/*! Same as above for a single lane queue */
+extern void
+gcs_sm_lane_stats_get (gcs_sm_t*     sm,
+                       gcs_sm_lane_t lane,
+                       int*          q_len,
+                       int*          q_len_max,
+                       int*          q_len_min,
+                       double*       q_len_avg);
+
+/*! sets the number of fast lane entries per one bulk lane entry */
+extern void
+gcs_sm_set_lane_weight (gcs_sm_t* sm, long weight);
+
 /*! resets average/max/min stats calculation */
 extern void
 gcs_sm_stats_flush(gcs_sm_t* sm);
@@ -164,6 +164,63 @@ START_TEST (gcs_defrag_test)
 }
 END_TEST
 
+START_TEST (gcs_defrag_test_hdr_only)
+{
+    ssize_t ret;
+
+    char         act_buf[]  = "Test action smuction";
+    size_t       act_len    = sizeof (act_buf);
+    size_t       frag1_len  = act_len / 2;
+
+    gcs_act_frag_t frg1, frg2;
+
+    gcs_defrag_t defrag;
+    struct gcs_act recv_act;
+
+    frg1.act_id    = getpid();
+    frg1.act_size  = act_len;
+    frg1.frag      = act_buf;
+    frg1.frag_len  = frag1_len;
+    frg1.frag_no   = 0;
+    frg1.act_type  = GCS_ACT_TORDERED;
+    frg1.proto_ver = 0;
+
+    frg2 = frg1;
+    frg2.frag     = act_buf + frag1_len;
+    frg2.frag_len = act_len - frag1_len;
+    frg2.frag_no  = frg1.frag_no + 1;
+
+    gcs_defrag_init (&defrag, NULL, true);
+    defrag_check_init (&defrag);
+
+    // payload is neither allocated nor copied, but fragments are tracked
+    ret = gcs_defrag_handle_frag (&defrag, &frg1, &recv_act, FALSE);
+    fail_if (ret != 0);
+    fail_if (defrag.head != NULL);
+    fail_if (defrag.received != frag1_len);
+
+    ret = gcs_defrag_handle_frag (&defrag, &frg2, &recv_act, FALSE);
+    fail_if (ret != (long)act_len);
+    fail_if (recv_act.buf != NULL);
+    fail_if (recv_act.buf_len != (long)act_len);
+    defrag_check_init (&defrag);
+    fail_if (!defrag.hdr_only); // mode survives action completion
+
+    // local action reset and resent with different size
+    ret = gcs_defrag_handle_frag (&defrag, &frg1, &recv_act, TRUE);
+    fail_if (ret != 0);
+    gcs_defrag_reset (&defrag);
+    frg1.act_size = frag1_len;
+    ret = gcs_defrag_handle_frag (&defrag, &frg1, &recv_act, TRUE);
+    fail_if (ret != (long)frag1_len);
+    fail_if (recv_act.buf != NULL);
+
+    gcs_defrag_free (&defrag);
+    defrag_check_init (&defrag);
+    fail_if (!defrag.hdr_only);
+}
+END_TEST
+
 Suite *gcs_defrag_suite(void)
 {
   Suite *suite = suite_create("GCS defragmenter");
@@ -171,6 +228,7 @@ Suite *gcs_defrag_suite(void)
 
   suite_add_tcase (suite, tcase);
   tcase_add_test  (tcase, gcs_defrag_test);
+  tcase_add_test  (tcase, gcs_defrag_test_hdr_only);
   return suite;
 }
 
@@ -80,6 +80,26 @@ START_TEST (gcs_fifo_lite_test)
 
     fail_if (fifo->used != 0, "fifo->used for empty queue is %ld", fifo->used);
 
+    // test swap, also across the ring buffer boundary
+    fail_if (gcs_fifo_lite_swap_tail (fifo), "swapped tail of empty FIFO");
+    for (i = 1; i <= FIFO_LENGTH; i++) {
+        item = (long*)gcs_fifo_lite_get_tail (fifo);
+        fail_if (NULL == item, "gcs_fifo_lite_get_tail() returned NULL");
+        *item = i;
+        gcs_fifo_lite_push_tail (fifo);
+        fail_if (gcs_fifo_lite_swap_tail (fifo) != (i > 1),
+                 "gcs_fifo_lite_swap_tail() failed, i = %ld", i);
+    }
+    // every item went in front of the previous one, except for the first
+    for (i = 2; i <= FIFO_LENGTH + 1; i++) {
+        item = (long*)gcs_fifo_lite_get_head (fifo);
+        fail_if (NULL == item, "gcs_fifo_lite_get_head() returned NULL");
+        fail_if (*item != (i <= FIFO_LENGTH ? i : 1),
+                 "gcs_fifo_lite_get_head() returned %ld, expected %ld",
+                 *item, (i <= FIFO_LENGTH ? i : 1));
+        gcs_fifo_lite_pop_head (fifo);
+    }
+
     ret = gcs_fifo_lite_destroy (fifo);
     fail_if (ret != 0, "gcs_fifo_lite_destroy() failed: %d", ret);
 }
@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "gcs_node_test.hpp"
 #include "../gcs_node.hpp"
 
@@ -55,6 +56,74 @@ START_TEST (gcs_node_test)
 }
 END_TEST
 
+static void
+node_test_frag (gcs_act_frag_t* frg, gcs_seqno_t act_id, size_t act_size,
+                unsigned long frag_no, const char* frag)
+{
+    frg->act_id    = act_id;
+    frg->act_size  = act_size;
+    frg->frag      = frag;
+    frg->frag_len  = strlen(frag);
+    frg->frag_no   = frag_no;
+    frg->act_type  = GCS_ACT_TORDERED;
+    frg->proto_ver = 1;
+}
+
+START_TEST (gcs_node_test_interleave)
+{
+    /* fragments of a long action interleaved with shorter ones */
+    gcs_node_t node;
+    gcs_act_frag_t frg;
+    struct gcs_act act;
+    ssize_t ret;
+
+    gcs_node_init (&node, NULL, NODE_ID, NODE_NAME, NODE_ADDR, 1, 0, 0, 0);
+
+    node_test_frag (&frg, 1, 9, 0, "abc");
+    fail_if (gcs_node_other_act_pending (&node, &frg));
+    ret = gcs_node_handle_act_frag (&node, &frg, &act, false);
+    fail_if (ret != 0, "ret = %zd, expected 0", ret);
+
+    /* single fragment action */
+    node_test_frag (&frg, 2, 3, 0, "xyz");
+    fail_if (!gcs_node_other_act_pending (&node, &frg));
+    ret = gcs_node_handle_act_frag (&node, &frg, &act, false);
+    fail_if (ret != 3, "ret = %zd, expected 3", ret);
+    fail_if (memcmp (act.buf, "xyz", 3));
+    free (const_cast<void*>(act.buf));
+
+    node_test_frag (&frg, 1, 9, 1, "def");
+    fail_if (gcs_node_other_act_pending (&node, &frg));
+    ret = gcs_node_handle_act_frag (&node, &frg, &act, false);
+    fail_if (ret != 0, "ret = %zd, expected 0", ret);
+
+    /* two fragment action */
+    node_test_frag (&frg, 3, 6, 0, "123");
+    ret = gcs_node_handle_act_frag (&node, &frg, &act, false);
+    fail_if (ret != 0, "ret = %zd, expected 0", ret);
+    node_test_frag (&frg, 3, 6, 1, "456");
+    ret = gcs_node_handle_act_frag (&node, &frg, &act, false);
+    fail_if (ret != 6, "ret = %zd, expected 6", ret);
+    fail_if (memcmp (act.buf, "123456", 6));
+    free (const_cast<void*>(act.buf));
+
+    node_test_frag (&frg, 1, 9, 2, "ghi");
+    ret = gcs_node_handle_act_frag (&node, &frg, &act, false);
+    fail_if (ret != 9, "ret = %zd, expected 9", ret);
+    fail_if (memcmp (act.buf, "abcdefghi", 9));
+    free (const_cast<void*>(act.buf));
+
+    /* both defragmenters are free again */
+    node_test_frag (&frg, 4, 3, 0, "klm");
+    fail_if (gcs_node_other_act_pending (&node, &frg));
+    ret = gcs_node_handle_act_frag (&node, &frg, &act, false);
+    fail_if (ret != 3, "ret = %zd, expected 3", ret);
+    free (const_cast<void*>(act.buf));
+
+    gcs_node_free (&node);
+}
+END_TEST
+
 Suite *gcs_node_suite(void)
 {
     Suite *suite = suite_create("GCS node context");
@@ -62,6 +131,7 @@ Suite *gcs_node_suite(void)
 
     suite_add_tcase (suite, tcase);
     tcase_add_test  (tcase, gcs_node_test);
+    tcase_add_test  (tcase, gcs_node_test_interleave);
     return suite;
 }
 
@@ -99,10 +99,10 @@ START_TEST (gcs_sm_test_simple)
     gu_thread_join (t4, NULL); // there's no space in the queue
     fail_if (simple_ret != -EAGAIN);
 
-    fail_if (0 != sm->wait_q_tail, "wait_q_tail = %lu, expected 0",
-             sm->wait_q_tail);
-    fail_if (1 != sm->wait_q_head, "wait_q_head = %lu, expected 1",
-             sm->wait_q_head);
+    fail_if (0 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 0",
+             sm->wait_q_tail[GCS_SM_FAST]);
+    fail_if (1 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 1",
+             sm->wait_q_head[GCS_SM_FAST]);
     fail_if (4 != sm->users, "users = %lu, expected 4", sm->users);
 
     gu_info ("Calling gcs_sm_leave()");
@@ -157,10 +157,10 @@ START_TEST (gcs_sm_test_close)
     fail_if(sm->users != 1, "users = %ld, expected 1", sm->users);
     fail_if(order != 0);
 
-    fail_if(1 != sm->wait_q_head, "wait_q_head = %lu, expected 1",
-            sm->wait_q_head);
-    fail_if(1 != sm->wait_q_tail, "wait_q_tail = %lu, expected 1",
-            sm->wait_q_tail);
+    fail_if(1 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 1",
+            sm->wait_q_head[GCS_SM_FAST]);
+    fail_if(1 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 1",
+            sm->wait_q_tail[GCS_SM_FAST]);
 
     gu_thread_t thr;
     gu_thread_create (&thr, NULL, closing_thread, sm);
@@ -171,10 +171,10 @@ START_TEST (gcs_sm_test_close)
     fail_if(sm->users != 2, "users = %ld, expected 2", sm->users);
     gu_info ("Started close thread, users = %ld", sm->users);
 
-    fail_if(1 != sm->wait_q_head, "wait_q_head = %lu, expected 1",
-            sm->wait_q_head);
-    fail_if(0 != sm->wait_q_tail, "wait_q_tail = %lu, expected 0",
-            sm->wait_q_tail);
+    fail_if(1 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 1",
+            sm->wait_q_head[GCS_SM_FAST]);
+    fail_if(0 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 0",
+            sm->wait_q_tail[GCS_SM_FAST]);
     fail_if(1 != sm->entered);
 
     order = 2;
@@ -229,8 +229,8 @@ START_TEST (gcs_sm_test_pause)
     gcs_sm_t* sm = gcs_sm_create(4, 1);
 
     fail_if(!sm);
-    fail_if(1 != sm->wait_q_head, "wait_q_head = %lu, expected 1",
-            sm->wait_q_head);
+    fail_if(1 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 1",
+            sm->wait_q_head[GCS_SM_FAST]);
 
     gu_cond_t cond;
     gu_cond_init (&cond, NULL);
@@ -271,10 +271,10 @@ START_TEST (gcs_sm_test_pause)
     gu_thread_join (thr, NULL);
     fail_if (pause_order != 3, "pause_order = %d, expected 3");
 
-    fail_if(2 != sm->wait_q_head, "wait_q_head = %lu, expected 2",
-            sm->wait_q_head);
-    fail_if(1 != sm->wait_q_tail, "wait_q_tail = %lu, expected 1",
-            sm->wait_q_tail);
+    fail_if(2 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 2",
+            sm->wait_q_head[GCS_SM_FAST]);
+    fail_if(1 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 1",
+            sm->wait_q_tail[GCS_SM_FAST]);
 
     // testing taking stats in the middle of the pause pt. 2
     long long tmp;
@@ -288,8 +288,8 @@ START_TEST (gcs_sm_test_pause)
 
     // Testing scheduling capability
     gcs_sm_schedule (sm);
-    fail_if(2 != sm->wait_q_tail, "wait_q_tail = %lu, expected 2",
-            sm->wait_q_tail);
+    fail_if(2 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 2",
+            sm->wait_q_tail[GCS_SM_FAST]);
     gu_thread_create (&thr, NULL, pausing_thread, sm);
     usleep (TEST_USLEEP);
     // no changes in pause_order
@@ -304,10 +304,10 @@ START_TEST (gcs_sm_test_pause)
     fail_if (pause_order != 1, "pause_order = %d, expected 1");
     fail_if (sm->users != 2, "users = %ld, expected 2", sm->users);
 
-    fail_if(2 != sm->wait_q_head, "wait_q_head = %lu, expected 2",
-            sm->wait_q_head);
-    fail_if(3 != sm->wait_q_tail, "wait_q_tail = %lu, expected 3",
-            sm->wait_q_tail);
+    fail_if(2 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 2",
+            sm->wait_q_head[GCS_SM_FAST]);
+    fail_if(3 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 3",
+            sm->wait_q_tail[GCS_SM_FAST]);
 
     gcs_sm_stats_get (sm, &q_len, &q_len_max, &q_len_min, &q_len_avg,
                       &tmp, &paused_avg);
@@ -343,10 +343,10 @@ START_TEST (gcs_sm_test_pause)
     fail_if (sm->users   != 1, "users = %ld, expected 1", sm->users);
     fail_if (sm->entered != 0, "entered = %ld, expected 1", sm->entered);
 
-    fail_if(3 != sm->wait_q_head, "wait_q_head = %lu, expected 3",
-            sm->wait_q_head);
-    fail_if(3 != sm->wait_q_tail, "wait_q_tail = %lu, expected 3",
-            sm->wait_q_tail);
+    fail_if(3 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 3",
+            sm->wait_q_head[GCS_SM_FAST]);
+    fail_if(3 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 3",
+            sm->wait_q_tail[GCS_SM_FAST]);
 
     usleep (TEST_USLEEP); // nothing should change, since monitor is paused
     fail_if (pause_order != 2, "pause_order = %d, expected 2");
@@ -367,14 +367,14 @@ START_TEST (gcs_sm_test_pause)
     gcs_sm_enter (sm, &cond, false, true); // by now paused thread exited monitor
     fail_if (sm->entered != 1, "entered = %ld, expected 1", sm->entered);
     fail_if (sm->users   != 1, "users = %ld, expected 1", sm->users);
-    fail_if(0 != sm->wait_q_head, "wait_q_head = %lu, expected 0",
-            sm->wait_q_head);
-    fail_if(0 != sm->wait_q_tail, "wait_q_tail = %lu, expected 0",
-            sm->wait_q_tail);
+    fail_if(0 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 0",
+            sm->wait_q_head[GCS_SM_FAST]);
+    fail_if(0 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 0",
+            sm->wait_q_tail[GCS_SM_FAST]);
 
     gcs_sm_leave (sm);
-    fail_if(1 != sm->wait_q_head, "wait_q_head = %lu, expected 1",
-            sm->wait_q_head);
+    fail_if(1 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 1",
+            sm->wait_q_head[GCS_SM_FAST]);
 
     mark_point();
     gu_cond_destroy(&cond);
@@ -413,8 +413,9 @@ static void* interrupt_thread(void* arg)
     global_handle = -1;                                                 \
     gu_thread_create (thr, NULL, interrupt_thread, sm);                 \
     WAIT_FOR(global_handle == h);                                       \
-    fail_if (sm->wait_q_tail != tail, "wait_q_tail = %lu, expected %lu", \
-             sm->wait_q_tail, tail);                                    \
+    fail_if (sm->wait_q_tail[GCS_SM_FAST] != tail,                      \
+             "wait_q_tail = %lu, expected %lu",                         \
+             sm->wait_q_tail[GCS_SM_FAST], tail);                       \
     fail_if (global_handle != h, "global_handle = %ld, expected %ld",   \
              global_handle, h);                                         \
     fail_if (sm->users != u, "users = %ld, expected %ld", sm->users, u);
@@ -441,8 +442,8 @@ START_TEST (gcs_sm_test_interrupt)
 
     long handle = gcs_sm_schedule (sm);
     fail_if (handle != 0, "handle = %ld, expected 0");
-    fail_if (sm->wait_q_tail != 1, "wait_q_tail = %lu, expected 1",
-             sm->wait_q_tail);
+    fail_if (sm->wait_q_tail[GCS_SM_FAST] != 1, "wait_q_tail = %lu, expected 1",
+             sm->wait_q_tail[GCS_SM_FAST]);
 
     long ret = gcs_sm_enter (sm, &cond, true, true);
     fail_if (ret != 0);
@@ -495,10 +496,10 @@ START_TEST (gcs_sm_test_interrupt)
     ret = gcs_sm_enter (sm, &cond, false, true);
     fail_if (ret != 0);
 
-    fail_if(1 != sm->wait_q_head, "wait_q_head = %lu, expected 1",
-            sm->wait_q_head);
-    fail_if(1 != sm->wait_q_tail, "wait_q_tail = %lu, expected 1",
-            sm->wait_q_tail);
+    fail_if(1 != sm->wait_q_head[GCS_SM_FAST], "wait_q_head = %lu, expected 1",
+            sm->wait_q_head[GCS_SM_FAST]);
+    fail_if(1 != sm->wait_q_tail[GCS_SM_FAST], "wait_q_tail = %lu, expected 1",
+            sm->wait_q_tail[GCS_SM_FAST]);
     fail_if (sm->users != 1, "users = %ld, expected 1", sm->users);
 
     TEST_CREATE_THREAD(&thr1, 2, 3, 2);
@@ -514,6 +515,192 @@ START_TEST (gcs_sm_test_interrupt)
 }
 END_TEST
 
+static volatile long lend_entered;
+
+static void* lend_thread(void* arg)
+{
+    gcs_sm_t* sm = (gcs_sm_t*) arg;
+
+    gu_cond_t cond;
+    gu_cond_init (&cond, NULL);
+
+    if (0 == (simple_ret = gcs_sm_enter (sm, &cond, false, true))) {
+        lend_entered++;
+        usleep(1000);
+        gcs_sm_leave (sm);
+    }
+
+    gu_cond_destroy (&cond);
+
+    return NULL;
+}
+
+START_TEST (gcs_sm_test_lend)
+{
+    gcs_sm_t* sm = gcs_sm_create(4, 1);
+    fail_if(!sm);
+
+    gu_cond_t cond;
+    gu_cond_init (&cond, NULL);
+
+    long ret = gcs_sm_enter(sm, &cond, false, true);
+    fail_if(ret, "gcs_sm_enter() failed: %d (%s)", ret, strerror(-ret));
+
+    /* nobody to lend to */
+    fail_if(gcs_sm_lend(sm, &cond));
+
+    lend_entered = 0;
+    gu_thread_t t1, t2;
+    gu_thread_create (&t1, NULL, lend_thread, sm);
+    WAIT_FOR(2 == sm->users);
+    gu_thread_create (&t2, NULL, lend_thread, sm);
+    WAIT_FOR(3 == sm->users);
+    fail_if(3 != sm->users, "users = %ld, expected 3", sm->users);
+
+    /* next waiter enters and leaves, we are still inside */
+    fail_if(!gcs_sm_lend(sm, &cond));
+    gu_thread_join (t1, NULL);
+    fail_if(1 != lend_entered, "lend_entered = %ld, expected 1",
+            lend_entered);
+    fail_if(simple_ret, "simple_ret = %ld, expected 0", simple_ret);
+    fail_if(2 != sm->users, "users = %ld, expected 2", sm->users);
+    fail_if(1 != sm->entered, "entered = %ld, expected 1", sm->entered);
+
+    /* pause prevents lending */
+    gcs_sm_pause (sm);
+    fail_if(gcs_sm_lend(sm, &cond));
+    gcs_sm_continue (sm);
+    fail_if(1 != lend_entered, "lend_entered = %ld, expected 1",
+            lend_entered);
+
+    fail_if(!gcs_sm_lend(sm, &cond));
+    gu_thread_join (t2, NULL);
+    fail_if(2 != lend_entered, "lend_entered = %ld, expected 2",
+            lend_entered);
+    fail_if(1 != sm->users, "users = %ld, expected 1", sm->users);
+
+    gcs_sm_leave(sm);
+    fail_if(0 != sm->users, "users = %ld, expected 0", sm->users);
+    fail_if(0 != sm->entered, "entered = %ld, expected 0", sm->entered);
+
+    /* check that monitor is still functional */
+    ret = gcs_sm_enter(sm, &cond, false, true);
+    fail_if(ret, "gcs_sm_enter() failed: %d (%s)", ret, strerror(-ret));
+    gcs_sm_leave(sm);
+
+    gu_cond_destroy (&cond);
+    gcs_sm_close (sm);
+    gcs_sm_destroy (sm);
+}
+END_TEST
+
+struct lane_user
+{
+    gcs_sm_t*     sm;
+    gcs_sm_lane_t lane;
+    long          id;
+    volatile long handle;
+    volatile long ret;
+};
+
+static volatile long lane_order[4];
+static volatile long lane_entered;
+
+static void* lane_thread(void* arg)
+{
+    struct lane_user* const u = (struct lane_user*) arg;
+
+    gu_cond_t cond;
+    gu_cond_init (&cond, NULL);
+
+    if ((u->handle = gcs_sm_schedule (u->sm, u->lane)) >= 0) {
+        if (0 == (u->ret = gcs_sm_enter (u->sm, &cond, true, true))) {
+            lane_order[lane_entered++] = u->id;
+            gcs_sm_leave (u->sm);
+        }
+    }
+
+    gu_cond_destroy (&cond);
+
+    return NULL;
+}
+
+START_TEST (gcs_sm_test_lanes)
+{
+    gcs_sm_t* sm = gcs_sm_create(4, 1);
+    fail_if(!sm);
+
+    gcs_sm_set_lane_weight (sm, 1);
+
+    gu_cond_t cond;
+    gu_cond_init (&cond, NULL);
+
+    long ret = gcs_sm_enter(sm, &cond, false, true);
+    fail_if(ret, "gcs_sm_enter() failed: %d (%s)", ret, strerror(-ret));
+
+    /* bulk lane waiters arrive first */
+    gcs_sm_lane_t const lanes[5] =
+        { GCS_SM_BULK, GCS_SM_BULK, GCS_SM_FAST, GCS_SM_FAST, GCS_SM_BULK };
+    struct lane_user u[5];
+    gu_thread_t      t[5];
+
+    lane_entered = 0;
+    for (int i = 0; i < 5; ++i) {
+        u[i].sm     = sm;
+        u[i].lane   = lanes[i];
+        u[i].id     = i;
+        u[i].handle = -1;
+        u[i].ret    = -1;
+        gu_thread_create (&t[i], NULL, lane_thread, &u[i]);
+        WAIT_FOR(i + 2 == sm->users);
+        fail_if(i + 2 != sm->users, "users = %ld, expected %d",
+                sm->users, i + 2);
+    }
+
+    int len, len_max, len_min;
+    double len_avg;
+    gcs_sm_lane_stats_get (sm, GCS_SM_BULK, &len, &len_max, &len_min,
+                           &len_avg);
+    fail_if(3 != len, "bulk q_len = %d, expected 3", len);
+    fail_if(3 != len_max, "bulk q_len_max = %d, expected 3", len_max);
+    gcs_sm_lane_stats_get (sm, GCS_SM_FAST, &len, &len_max, &len_min,
+                           &len_avg);
+    fail_if(3 != len, "fast q_len = %d, expected 3", len);
+    fail_if(1.0 != len_avg, "fast q_len_avg = %f, expected 1.0", len_avg);
+
+    /* handles of bulk lane waiters point past the fast lane ring */
+    fail_if(u[0].handle != (long)sm->wait_q_len + 2, "handle = %ld",
+            u[0].handle);
+    fail_if(u[2].handle != 3, "handle = %ld", u[2].handle);
+
+    ret = gcs_sm_interrupt (sm, u[4].handle);
+    fail_if(ret, "gcs_sm_interrupt() failed: %d (%s)", ret, strerror(-ret));
+    gu_thread_join (t[4], NULL);
+    fail_if(-EINTR != u[4].ret, "ret = %ld, expected -EINTR", u[4].ret);
+
+    gcs_sm_leave(sm);
+
+    for (int i = 0; i < 4; ++i) gu_thread_join (t[i], NULL);
+
+    /* with weight 1 lanes alternate, starting with the fast lane */
+    long const expected[4] = { 2, 0, 3, 1 };
+    fail_if(4 != lane_entered, "lane_entered = %ld, expected 4",
+            lane_entered);
+    for (int i = 0; i < 4; ++i) {
+        fail_if(expected[i] != lane_order[i], "lane_order[%d] = %ld, "
+                "expected %ld", i, lane_order[i], expected[i]);
+        fail_if(u[i].ret, "u[%d].ret = %ld", i, u[i].ret);
+    }
+
+    fail_if(0 != sm->users, "users = %ld, expected 0", sm->users);
+    fail_if(0 != sm->lane[GCS_SM_BULK].users, "bulk users = %ld",
+            sm->lane[GCS_SM_BULK].users);
+
+    gu_cond_destroy (&cond);
+    gcs_sm_close (sm);
+    gcs_sm_destroy (sm);
+}
+END_TEST
 
 Suite *gcs_send_monitor_suite(void)
 {
@@ -526,6 +713,8 @@ Suite *gcs_send_monitor_suite(void)
   tcase_add_test  (tc, gcs_sm_test_close);
   tcase_add_test  (tc, gcs_sm_test_pause);
   tcase_add_test  (tc, gcs_sm_test_interrupt);
+  tcase_add_test  (tc, gcs_sm_test_lend);
+  tcase_add_test  (tc, gcs_sm_test_lanes);
   return s;
 }
 